@@ -18,6 +18,7 @@
 
 #include "cmd/package_parser.h"
 #include "resource_util.h"
+#include "task_group.h"
 #include "thread_pool.h"
 
 namespace OHOS {
@@ -35,18 +36,17 @@ protected:
     virtual uint32_t CopyBinaryFile(const std::vector<std::string> &inputs);
     uint32_t CheckCopyResults();
     uint32_t CopyBinaryFile(const std::string &input);
-    virtual bool IsDuplicated(const std::unique_ptr<FileEntry> &entry, std::string subPath);
+    virtual bool IsDuplicated(const std::string &path, const std::string &subPath);
     PackageParser packageParser_;
     std::string moduleName_;
-    std::mutex mutex_;
 
 private:
     uint32_t CopyBinaryFile(const std::string &filePath, const std::string &fileType);
     uint32_t CopyBinaryFileImpl(const std::string &src, const std::string &dst);
+    uint32_t CopyBinaryEntry(const FileEntry::DirEntry &entry, const std::string &path, const std::string &subPath);
     uint32_t CopySingleFile(const std::string &path, std::string &subPath);
     std::future<uint32_t> copyFuture_;
-    std::vector<std::future<uint32_t>> copyResults_;
-    std::atomic<bool> terminate_{false};
+    TaskGroup copyGroup_;
     uint32_t result_ = RESTOOL_SUCCESS;
 };
 } // namespace Restool
@@ -0,0 +1,55 @@
+/*
+ * Copyright (c) 2024 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef OHOS_RESTOOL_BYTE_BUDGET_H
+#define OHOS_RESTOOL_BYTE_BUDGET_H
+
+#include <condition_variable>
+#include <cstdint>
+#include <mutex>
+#include "singleton.h"
+
+namespace OHOS {
+namespace Global {
+namespace Restool {
+// bounds the bytes held in user space by the transcodes and buffered copies running at the same time, the callers
+// are admitted in the order they came so that a large file is not overtaken forever by small ones
+class ByteBudget : public Singleton<ByteBudget> {
+public:
+    /**
+     * @brief Set the budget, 0 means unbounded
+     */
+    void SetLimit(uint64_t limit);
+
+    /**
+     * @brief Wait until the earlier callers are admitted and the bytes fit in the budget, a file larger than the
+     * budget runs alone. The caller must not acquire again before it releases.
+     */
+    void Acquire(uint64_t bytes);
+
+    void Release(uint64_t bytes);
+
+private:
+    std::mutex mutex_;
+    std::condition_variable condition_;
+    uint64_t limit_ = 0;
+    uint64_t inflight_ = 0;
+    uint64_t nextTicket_ = 0;
+    uint64_t servingTicket_ = 0;
+};
+} // namespace Restool
+} // namespace Global
+} // namespace OHOS
+#endif
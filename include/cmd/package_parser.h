@@ -53,6 +53,9 @@ public:
     const std::string &GetCompressionPath() const;
     bool IsOverlap() const;
     size_t GetThreadCount() const;
+    size_t GetIoThreadCount() const;
+    LinkMode GetLinkMode() const;
+    uint64_t GetFadviseThreshold() const;
 
 private:
     void InitCommand();
@@ -85,6 +88,10 @@ private:
     uint32_t ParseTargetConfig(const std::string &argValue);
     uint32_t AddCompressionPath(const std::string &argValue);
     uint32_t ParseThread(const std::string &argValue);
+    uint32_t ParseIoThread(const std::string &argValue);
+    uint32_t ParseLinkMode(const std::string &argValue);
+    uint32_t ParseFadviseThreshold(const std::string &argValue);
+    uint32_t ParseThreadCount(const std::string &argValue, size_t &threadCount);
     uint32_t ParseIgnoreRegex(const std::string &argValue, const std::string &option);
 
     static const struct option CMD_OPTS[];
@@ -110,6 +117,9 @@ private:
     std::vector<std::string> sysIdDefinedPaths_;
     std::string compressionPath_;
     size_t threadCount_{ 0 };
+    size_t ioThreadCount_{ 0 };
+    LinkMode linkMode_{ LinkMode::COPY };
+    uint64_t fadviseThreshold_{ DEFAULT_FADVISE_THRESHOLD_MB * MB_SIZE };
     bool isOverlap_{ false };
 };
 } // namespace Restool
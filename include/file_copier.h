@@ -0,0 +1,90 @@
+/*
+ * Copyright (c) 2024 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef OHOS_RESTOOL_FILE_COPIER_H
+#define OHOS_RESTOOL_FILE_COPIER_H
+
+#include <atomic>
+#include <cstdint>
+#include <string>
+#include "resource_data.h"
+
+namespace OHOS {
+namespace Global {
+namespace Restool {
+// the ways a file gets to the output, the copies from the cheapest to the most expensive
+enum class CopyMethod {
+    REFLINK = 0,     // ioctl FICLONE, the blocks are shared on btrfs and xfs
+    COPY_FILE_RANGE, // copied in the kernel, offloaded by nfs and other file systems
+    SENDFILE,        // copied in the kernel through the page cache
+    BUFFERED,        // read and written through a user space buffer
+    HARDLINK,
+    SYMLINK,
+    COUNT,
+};
+
+class FileCopier {
+public:
+    /**
+     * @brief Copy a file by the cheapest method the file systems support
+     * @param src the source file
+     * @param dst the destination file, created or truncated
+     * @return false if the copy fails, errno tells why
+     */
+    static bool Copy(const std::string &src, const std::string &dst);
+
+    /**
+     * @brief Link the destination to the source, copy it if the link can not be made, such as across file systems
+     * @param src the source file
+     * @param dst the destination file, replaced if it exists
+     * @param linkMode the kind of link
+     * @return false if the copy fails, errno tells why
+     */
+    static bool LinkOrCopy(const std::string &src, const std::string &dst, LinkMode linkMode);
+
+    /**
+     * @brief Set the size from which a copy reads the source sequentially and drops both files from the page cache
+     * when done, so that a big rawfile tree does not evict the data the build reads again
+     * @param threshold the size in bytes, 0 keeps all files in the page cache
+     */
+    static void SetFadviseThreshold(uint64_t threshold);
+
+    /**
+     * @brief Get the count of files copied by each method
+     */
+    static std::string PrintCopyMessage();
+
+private:
+#ifdef __LINUX__
+    enum class CopyResult {
+        SUCCESS,
+        UNSUPPORTED,
+        FAILED,
+    };
+
+    static CopyResult Reflink(int in, int out);
+    static CopyResult CopyFileRange(int in, int out);
+    static CopyResult SendFile(int in, int out);
+    static CopyResult CopyBuffered(int in, int out);
+    static CopyResult CopyThroughBuffer(int in, int out);
+    static void DropCache(int in, int out);
+#endif
+    static std::atomic<uint64_t> copyCounts_[static_cast<size_t>(CopyMethod::COUNT)];
+    static std::atomic<uint64_t> fadviseThreshold_;
+};
+} // namespace Restool
+} // namespace Global
+} // namespace OHOS
+#endif
@@ -16,39 +16,80 @@
 #ifndef OHOS_RESTOOL_FILE_ENTRY_H
 #define OHOS_RESTOOL_FILE_ENTRY_H
 
+#include <cstdint>
 #include <memory>
 #include <vector>
 #include <string>
+#include <string_view>
+#include "resource_data.h"
 
 namespace OHOS {
 namespace Global {
 namespace Restool {
 class FileEntry {
 public:
+    // the path and the offsets of its parts, the parts are views into the path and cost no allocation
     class FilePath {
     public:
         FilePath(const std::string &path);
+        FilePath(std::string &&path);
         virtual ~FilePath();
         FilePath Append(const std::string &path);
         FilePath ReplaceExtension(const std::string &extension);
         FilePath GetParent();
+
+        /**
+         * @brief Append a segment in place, the buffer of the path is reused by the next Push after a Pop
+         * @param path the segment
+         * @return this path
+         */
+        FilePath &Push(std::string_view path);
+
+        /**
+         * @brief Drop the last segment in place, the path becomes GetParent()
+         * @return this path
+         */
+        FilePath &Pop();
         const std::string &GetPath() const;
-        const std::string &GetFilename() const;
-        const std::string &GetExtension() const;
+        std::string_view GetParentPath() const;
+        std::string_view GetFilename() const;
+        std::string_view GetExtension() const;
         const std::vector<std::string> GetSegments() const;
+
+        /**
+         * @brief Get the extension of a path without building a FilePath, the same as FilePath(path).GetExtension()
+         */
+        static std::string_view GetExtension(std::string_view path);
     private:
         void Init();
-        void Format();
+        bool Format();
         std::string filePath_;
-        std::string filename_;
-        std::string parent_;
-        std::string extension_;
+        // npos if the path has no separator
+        std::string::size_type parentEnd_ = std::string::npos;
+        std::string::size_type filenamePos_ = 0;
+        // npos if the filename has no extension
+        std::string::size_type extensionPos_ = std::string::npos;
+    };
+
+    // a child listed from a directory, without a FileEntry and its parsed FilePath
+    struct DirEntry {
+        std::string name;
+        bool isFile;
     };
 
     FileEntry(const std::string &path);
     virtual ~FileEntry();
     bool Init();
     const std::vector<std::unique_ptr<FileEntry>> GetChilds() const;
+
+    /**
+     * @brief List the children of a directory, the type comes from the directory entry and a stat is only made
+     * when the file system does not report it
+     * @param path the directory
+     * @param entries the children, "." and ".." excluded
+     * @return false if the directory can not be opened
+     */
+    static bool ListDir(const std::string &path, std::vector<DirEntry> &entries);
     bool IsFile() const;
     const FilePath &GetFilePath() const;
     static bool Exist(const std::string &path);
@@ -56,17 +97,20 @@ public:
     static bool RemoveFile(const std::string &path);
     static bool CreateDirs(const std::string &path);
     static bool CopyFileInner(const std::string &src, const std::string &dst);
+    static bool LinkFileInner(const std::string &src, const std::string &dst, LinkMode linkMode);
     static bool IsDirectory(const std::string &path);
+    static uint64_t GetFileSize(const std::string &path);
     static std::string RealPath(const std::string &path);
     static std::string AdaptLongPath(const std::string &path);
+    static const std::string SEPARATE;
 
 private:
-    bool IsIgnore(const std::string &filename) const;
+    static bool IsIgnore(const std::string &filename);
     static bool RemoveAllDirInner(const FileEntry &entry);
     static bool CreateDirsInner(const std::string &path, std::string::size_type offset);
+    static bool MakeDir(const std::string &path);
     FilePath filePath_;
     bool isFile_;
-    static const std::string SEPARATE;
 };
 }
 }
@@ -0,0 +1,76 @@
+/*
+ * Copyright (c) 2024 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef OHOS_RESTOOL_FILE_INFO_QUEUE_H
+#define OHOS_RESTOOL_FILE_INFO_QUEUE_H
+
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <vector>
+#include "resource_data.h"
+
+namespace OHOS {
+namespace Global {
+namespace Restool {
+// the files of one resource type, pushed a directory at a time by the walker on the io pool and popped by the
+// compiler of the type, so that compiling starts before the walk ends
+class FileInfoQueue {
+public:
+    /**
+     * @brief Push the files of a directory
+     */
+    void Push(std::vector<FileInfo> &&fileInfos);
+
+    /**
+     * @brief No more files, Pop returns false once the queue is empty
+     */
+    void Close();
+
+    /**
+     * @brief The walk failed, Pop returns false at once
+     */
+    void Cancel();
+
+    /**
+     * @brief Wait for the files of the next directory
+     * @param fileInfos the files
+     * @return false if the queue is closed and empty or cancelled
+     */
+    bool Pop(std::vector<FileInfo> &fileInfos);
+
+    /**
+     * @brief Wait for the first directory
+     * @return false if the queue is closed without any directory pushed
+     */
+    bool WaitFirst();
+
+    bool IsCancelled();
+
+private:
+    // a worker of a pool runs the queued tasks of its pool until the walker has pushed something
+    void WaitFor(std::unique_lock<std::mutex> &lock, const std::function<bool()> &isReady);
+    std::mutex mutex_;
+    std::condition_variable condition_;
+    std::deque<std::vector<FileInfo>> batches_;
+    bool pushed_ = false;
+    bool closed_ = false;
+    bool cancelled_ = false;
+};
+} // namespace Restool
+} // namespace Global
+} // namespace OHOS
+#endif
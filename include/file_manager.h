@@ -19,6 +19,7 @@
 #include <vector>
 #include "resource_data.h"
 #include "resource_item.h"
+#include "resource_module.h"
 #include "singleton.h"
 
 namespace OHOS {
@@ -44,7 +45,7 @@ public:
     void SetScanHap(bool state);
 
 private:
-    uint32_t ScanModule(const std::string &input, const std::string &output);
+    uint32_t CommitModule(ResourceModule &resourceModule);
     uint32_t ParseReference(const std::string &output);
     void CheckAllItems(std::vector<std::pair<ResType, std::string>> &noBaseResource);
     bool ScaleIcon(const std::string &output, ResourceItem &item);
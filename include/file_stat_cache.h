@@ -0,0 +1,84 @@
+/*
+ * Copyright (c) 2024 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef OHOS_RESTOOL_FILE_STAT_CACHE_H
+#define OHOS_RESTOOL_FILE_STAT_CACHE_H
+
+#include <atomic>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include "singleton.h"
+
+namespace OHOS {
+namespace Global {
+namespace Restool {
+struct FileStat {
+    bool exist = false;
+    bool isDirectory = false;
+    uint64_t size = 0;
+    int64_t mtime = 0;
+};
+
+// the metadata of the paths stat'ed in this run, shared by all threads. A missing path is not cached, so a path
+// created later, by any spelling or by a library, is seen at once; restool invalidates the paths it writes or
+// removes.
+class FileStatCache : public Singleton<FileStatCache> {
+public:
+    /**
+     * @brief Get the metadata of the path, stat it on the first query
+     */
+    FileStat Get(const std::string &path);
+
+    /**
+     * @brief Stat the paths not cached yet while walking, before the copies query them one by one
+     */
+    void Prefetch(const std::vector<std::string> &paths);
+
+    /**
+     * @brief Drop the path after restool wrote it
+     */
+    void Invalidate(const std::string &path);
+
+    /**
+     * @brief Drop all paths, after restool removed a tree
+     */
+    void Clear();
+
+    /**
+     * @brief Get the count of Clear calls, the caches built on this one drop their content when it changes
+     */
+    uint64_t GetGeneration() const;
+
+private:
+    struct Shard {
+        std::mutex mutex;
+        std::unordered_map<std::string, FileStat> stats;
+        // bumped by Invalidate and Clear, a stat taken outside the lock is not stored if it changed meanwhile
+        uint64_t version = 0;
+    };
+
+    static constexpr size_t SHARD_COUNT = 16;
+    static FileStat Stat(const std::string &path);
+    Shard &GetShard(const std::string &path);
+    Shard shards_[SHARD_COUNT];
+    std::atomic<uint64_t> generation_{ 0 };
+};
+} // namespace Restool
+} // namespace Global
+} // namespace OHOS
+#endif
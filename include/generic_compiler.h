@@ -17,7 +17,6 @@
 #define OHOS_RESTOOL_GENERIC_COMPILER_H
 
 #include "i_resource_compiler.h"
-#include <mutex>
 
 namespace OHOS {
 namespace Global {
@@ -31,11 +30,13 @@ protected:
     std::string GetOutputFilePath(const FileInfo &fileInfo) const;
     virtual bool IsIgnore(const FileInfo &fileInfo);
     uint32_t CompileSingleFile(const FileInfo &fileInfo) override;
-    uint32_t CompileFiles(const std::vector<FileInfo> &fileInfos) override;
-    bool PostMediaFile(const FileInfo &fileInfo, const std::string &output);
-    std::mutex mutex_;
+    uint32_t CompileStream(FileInfoQueue &queue) override;
+    bool PostMediaFile(const FileInfo &fileInfo, const std::string &output, ResourceItem &resourceItem) const;
 
 private:
+    uint32_t CompileMediaFile(const FileInfo &fileInfo, ResourceItem &resourceItem);
+    // the files of the har and the profiles are copied as they are, the media of a hap may be transcoded
+    bool IsPlainCopy() const;
     bool CopyMediaFile(const FileInfo &fileInfo, std::string &output);
 };
 }
@@ -17,6 +17,7 @@
 #define OHOS_RESTOOL_RESOURCE_COMPILER_H
 
 #include <vector>
+#include "file_info_queue.h"
 #include "resource_data.h"
 #include "resource_item.h"
 
@@ -27,7 +28,18 @@ class IResourceCompiler {
 public:
     IResourceCompiler(ResType type, const std::string &output, bool isOverlap = false, bool isHarResource = false);
     virtual ~IResourceCompiler();
-    uint32_t Compile(const std::vector<DirectoryInfo> &directoryInfos);
+
+    /**
+     * @brief Compile the files popped from the queue until it is closed, the ids are left to a later Commit
+     * @param queue the files of the type, pushed by the directory walker
+     * @return RESTOOL_ERROR if the queue is cancelled or a file fails
+     */
+    uint32_t CompileWithoutCommit(FileInfoQueue &queue);
+
+    /**
+     * @brief Generate the ids of the compiled resources, the ids depend on the modules committed before
+     */
+    uint32_t Commit();
     const std::map<int64_t, std::vector<ResourceItem>> &GetResult() const;
     uint32_t Compile(const FileInfo &fileInfo);
     void SetModuleName(const std::string &moduleName);
@@ -36,8 +48,11 @@ public:
 
 protected:
     virtual uint32_t CompileSingleFile(const FileInfo &fileInfo);
+    virtual uint32_t CompileStream(FileInfoQueue &queue);
     virtual uint32_t CompileFiles(const std::vector<FileInfo> &fileInfos);
     bool MergeResourceItem(const ResourceItem &resourceItem);
+    // the item is moved into nameInfos_, its data is not copied again
+    bool MergeResourceItem(ResourceItem &&resourceItem);
     std::string GetOutputFolder(const DirectoryInfo &directoryInfo) const;
     ResType type_;
     std::string output_;
@@ -0,0 +1,79 @@
+/*
+ * Copyright (c) 2024 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef OHOS_RESTOOL_IGNORE_MATCHER_H
+#define OHOS_RESTOOL_IGNORE_MATCHER_H
+
+#include <map>
+#include <regex>
+#include <string>
+#include <vector>
+#include "resource_data.h"
+
+namespace OHOS {
+namespace Global {
+namespace Restool {
+// the ignore patterns compiled once, it is immutable after construction and shared by the scanning threads
+class IgnoreMatcher {
+public:
+    /**
+     * @param patterns the regex patterns and the file types they apply to, tried in the order of the map
+     * @param source the name of the patterns in the log, such as "default" or "user"
+     * @param ignoreCase whether the file name is lower cased before matching
+     * @param matchPath whether the patterns are matched against the file path too
+     */
+    IgnoreMatcher(const std::map<std::string, IgnoreType> &patterns, const std::string &source, bool ignoreCase,
+        bool matchPath);
+
+    /**
+     * @brief Check whether the file is ignored, the matched pattern is logged
+     * @param fileName the file name
+     * @param filePath the file path
+     * @param isFile whether it is a file or a directory
+     */
+    bool IsIgnored(const std::string &fileName, const std::string &filePath, bool isFile) const;
+
+private:
+    enum class Wildcard {
+        NONE,
+        ANY,       // ".*"
+        NON_EMPTY, // ".+"
+    };
+
+    // a pattern such as "\.git", ".+~" or "\..+" is a literal with an optional wildcard at either end, it is
+    // matched without the regex engine
+    struct Pattern {
+        std::string source;
+        IgnoreType type;
+        std::regex regex;
+        bool isLiteral = false;
+        Wildcard head = Wildcard::NONE;
+        std::string literal;
+        Wildcard tail = Wildcard::NONE;
+    };
+
+    static bool ParseLiteral(const std::string &source, Pattern &pattern);
+    static bool Match(const Pattern &pattern, const std::string &str);
+    static bool MatchLiteral(const Pattern &pattern, const std::string &str);
+
+    std::vector<Pattern> patterns_;
+    std::string source_;
+    bool ignoreCase_;
+    bool matchPath_;
+};
+} // namespace Restool
+} // namespace Global
+} // namespace OHOS
+#endif
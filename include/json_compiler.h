@@ -30,10 +30,19 @@ public:
     virtual ~JsonCompiler();
 protected:
     uint32_t CompileSingleFile(const FileInfo &fileInfo) override;
+    uint32_t CompileStream(FileInfoQueue &queue) override;
 private:
+    // parse a file into its items in the order of the file, the files are parsed at the same time
+    uint32_t ParseFile(const FileInfo &fileInfo, std::vector<ResourceItem> &resourceItems) const;
+    // the items are moved from
+    uint32_t MergeResourceItems(std::vector<ResourceItem> &resourceItems);
     void InitParser();
-    bool ParseJsonArrayLevel(const cJSON *arrayNode, const FileInfo &fileInfo);
-    bool ParseJsonObjectLevel(cJSON *objectNode, const FileInfo &fileInfo);
+    bool ParseJsonArrayLevel(const cJSON *arrayNode, const FileInfo &fileInfo, bool isBaseString,
+        std::vector<ResourceItem> &resourceItems) const;
+    bool ParseJsonItems(const std::vector<cJSON *> &items, size_t begin, size_t end, const FileInfo &fileInfo,
+        bool isBaseString, std::vector<ResourceItem> &resourceItems) const;
+    bool ParseJsonObjectLevel(cJSON *objectNode, const FileInfo &fileInfo, bool isBaseString,
+        std::vector<ResourceItem> &resourceItems) const;
 
     using HandleResource = std::function<bool(const cJSON *, ResourceItem&)>;
     bool HandleString(const cJSON *objectNode, ResourceItem &resourceItem) const;
@@ -62,8 +71,6 @@ private:
     bool CheckPluralValue(const cJSON *arrayItem, const ResourceItem &resourceItem) const;
     bool CheckColorValue(const char *s) const;
     std::map<ResType, HandleResource> handles_;
-    bool isBaseString_;
-    cJSON *root_;
 };
 }
 }
@@ -0,0 +1,70 @@
+/*
+ * Copyright (c) 2024 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef OHOS_RESTOOL_OUTPUT_TRASH_H
+#define OHOS_RESTOOL_OUTPUT_TRASH_H
+
+#include <cstdint>
+#include <future>
+#include <mutex>
+#include <string>
+#include <vector>
+#include "singleton.h"
+
+namespace OHOS {
+namespace Global {
+namespace Restool {
+// the output of an earlier build is renamed out of the way at once and deleted on the io pool while the new build
+// runs. The trash is named after the process, a trash left by a process that no longer runs is deleted too.
+class OutputTrash : public Singleton<OutputTrash> {
+public:
+    /**
+     * @brief Rename the directory to a trash name in the same parent directory
+     * @param path the directory
+     * @return false if the directory can not be renamed, it is left in place then
+     */
+    bool MoveToTrash(const std::string &path);
+
+    /**
+     * @brief Find the trash of the directory left by the processes that exited before deleting it
+     * @param path the directory
+     */
+    void CollectLeftovers(const std::string &path);
+
+    /**
+     * @brief Start deleting the trash on the io pool, the pool must be started
+     */
+    void RemoveAsync();
+
+    /**
+     * @brief Wait until the trash is deleted, the trash is deleted on the caller if RemoveAsync never ran
+     */
+    void Wait();
+
+private:
+    static std::string GetTrashPrefix(const std::string &path);
+    static bool IsProcessRunning(uint64_t pid);
+    static uint64_t GetProcessId();
+    static bool RemoveTree(const std::string &path);
+    static bool IsLink(const std::string &path);
+    static bool RemovePath(const std::string &path, bool isFile);
+    std::mutex mutex_;
+    std::vector<std::string> trashPaths_;
+    std::future<void> removeFuture_;
+};
+} // namespace Restool
+} // namespace Global
+} // namespace OHOS
+#endif
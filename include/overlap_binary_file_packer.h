@@ -27,7 +27,7 @@ public:
 
 protected:
     uint32_t CopyBinaryFile(const std::vector<std::string> &inputs);
-    bool IsDuplicated(const std::unique_ptr<FileEntry> &entry, std::string subPath);
+    bool IsDuplicated(const std::string &path, const std::string &subPath);
 };
 }
 }
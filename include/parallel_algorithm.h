@@ -0,0 +1,107 @@
+/*
+ * Copyright (c) 2024 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef OHOS_RESTOOL_PARALLEL_ALGORITHM_H
+#define OHOS_RESTOOL_PARALLEL_ALGORITHM_H
+
+#include <algorithm>
+#include <vector>
+#include "restool_errors.h"
+#include "task_group.h"
+#include "thread_pool.h"
+
+namespace OHOS {
+namespace Global {
+namespace Restool {
+// more chunks than threads, so that a slow chunk does not hold the others back
+constexpr size_t CHUNKS_PER_THREAD = 4;
+
+inline size_t GetChunkCount(size_t count, const ThreadPool &pool)
+{
+    size_t threadCount = pool.GetThreadCount();
+    if (threadCount == 0) {
+        // the pool is not started, everything runs on the caller
+        return std::min<size_t>(count, 1);
+    }
+    return std::min(count, threadCount * CHUNKS_PER_THREAD);
+}
+
+/**
+ * @brief Split [0, count) into contiguous chunks and run them in the pool
+ * @param count the count of the elements
+ * @param chunkCount the count of chunks
+ * @param func uint32_t(size_t chunk, size_t begin, size_t end), a failed chunk drops the chunks not started
+ * @param pool the pool to run in
+ */
+template <class F>
+uint32_t ParallelForChunks(size_t count, size_t chunkCount, F &&func, ThreadPool &pool = ThreadPool::GetInstance())
+{
+    if (chunkCount == 0) {
+        return RESTOOL_SUCCESS;
+    }
+    if (chunkCount == 1) {
+        return func(0, 0, count);
+    }
+    TaskGroup taskGroup(TaskPriority::HIGH, pool);
+    for (size_t chunk = 0; chunk < chunkCount; ++chunk) {
+        size_t begin = count * chunk / chunkCount;
+        size_t end = count * (chunk + 1) / chunkCount;
+        taskGroup.Spawn([&func, chunk, begin, end]() { return func(chunk, begin, end); });
+    }
+    return taskGroup.Wait();
+}
+
+/**
+ * @brief Run func on chunks of [0, count) in the pool, the caller returns when all chunks are done
+ * @param count the count of the elements
+ * @param func uint32_t(size_t begin, size_t end)
+ * @param pool the pool to run in
+ */
+template <class F>
+uint32_t ParallelFor(size_t count, F &&func, ThreadPool &pool = ThreadPool::GetInstance())
+{
+    return ParallelForChunks(count, GetChunkCount(count, pool),
+        [&func](size_t, size_t begin, size_t end) { return func(begin, end); }, pool);
+}
+
+/**
+ * @brief Reduce chunks of [0, count) into partial results in the pool, then merge them into result in the order
+ * of the chunks, so the result is the same as a serial loop however the chunks are scheduled
+ * @param count the count of the elements
+ * @param result the result to merge into
+ * @param func uint32_t(size_t begin, size_t end, T &partial)
+ * @param merge void(T &result, T &partial)
+ * @param pool the pool to run in
+ */
+template <class T, class F, class M>
+uint32_t ParallelReduce(size_t count, T &result, F &&func, M &&merge, ThreadPool &pool = ThreadPool::GetInstance())
+{
+    size_t chunkCount = GetChunkCount(count, pool);
+    std::vector<T> partials(chunkCount);
+    uint32_t ret = ParallelForChunks(count, chunkCount,
+        [&func, &partials](size_t chunk, size_t begin, size_t end) { return func(begin, end, partials[chunk]); },
+        pool);
+    if (ret != RESTOOL_SUCCESS) {
+        return ret;
+    }
+    for (auto &partial : partials) {
+        merge(result, partial);
+    }
+    return RESTOOL_SUCCESS;
+}
+} // namespace Restool
+} // namespace Global
+} // namespace OHOS
+#endif
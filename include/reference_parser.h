@@ -34,6 +34,7 @@ public:
     uint32_t ParseRefInString(std::string &value, bool &update, const std::string &filePath = "") const;
     static std::map<int64_t, std::set<int64_t>> &GetLayerIconIds();
 private:
+    uint32_t ParseRefInResourceItems(std::vector<ResourceItem> &resourceItems, const std::string &output);
     bool ParseRefJson(const std::string &from, const std::string &to);
     bool ParseRefResourceItemData(const ResourceItem &resourceItem, std::string &data, bool &update) const;
     bool IsStringOfResourceItem(ResType resType) const;
@@ -50,6 +51,8 @@ private:
     static const std::map<std::string, ResType> ID_REFS;
     static const std::map<std::string, ResType> ID_OHOS_REFS;
     static std::map<int64_t, std::set<int64_t>> layerIconIds_;
+    // where the layer icon ids are collected, a parser of a parallel chunk collects into its own partial map
+    std::map<int64_t, std::set<int64_t>> *layerIconIdsTarget_;
     cJSON *root_;
     bool isParsingMediaJson_;
     int64_t mediaJsonId_{ INVALID_ID };
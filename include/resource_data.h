@@ -53,8 +53,10 @@ static const std::string RESTOOLV2_NAME = "RestoolV2";
 static const std::string RESTOOL_VERSION = { " 6.1.0.002" };
 const static int32_t TAG_LEN = 4;
 constexpr static int DEFAULT_POOL_SIZE = 8;
-static std::set<std::string> g_resourceSet;
-static std::set<std::string> g_hapResourceSet;
+constexpr static size_t POOL_HIGH_WATER_MARK = 4096;
+constexpr static uint64_t MB_SIZE = 1024 * 1024;
+// the copies of files from this size on do not keep the data in the page cache
+constexpr static uint64_t DEFAULT_FADVISE_THRESHOLD_MB = 8;
 const static int8_t INVALID_ID = -1;
 const static int MIN_SUPPORT_NEW_MODULE_API_VERSION = 20;
 const static int MIN_SUPPORT_TS_HEADER_API_VERSION = 23;
@@ -66,6 +68,13 @@ enum class IgnoreType {
     IGNORE_ALL
 };
 
+// how the rawfile and resfile get to the output
+enum class LinkMode {
+    COPY,
+    HARDLINK,
+    SYMLINK
+};
+
 enum class KeyType {
     LANGUAGE = 0,
     REGION = 1,
@@ -160,6 +169,9 @@ enum Option {
     THREAD = 8,
     IGNORED_FILE = 9,
     IGNORED_PATH = 10,
+    IO_THREAD = 11,
+    LINK_MODE = 12,
+    FADVISE_THRESHOLD = 13,
     STARTID = 'e',
     FORCEWRITE = 'f',
     HELP = 'h',
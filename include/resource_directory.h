@@ -19,6 +19,8 @@
 #include <functional>
 #include <string>
 #include <map>
+#include <vector>
+#include "file_entry.h"
 #include "key_parser.h"
 
 namespace OHOS {
@@ -26,12 +28,24 @@ namespace Global {
 namespace Restool {
 class ResourceDirectory {
 public:
+    // called from the walking threads with a type directory and its files sorted by path
+    using DirectoryCallback = std::function<bool(const DirectoryInfo &, std::vector<FileInfo> &)>;
     ResourceDirectory() {};
     virtual ~ResourceDirectory() {};
-    bool ScanResources(const std::string &resourcesDir, std::function<bool(const DirectoryInfo&)> callback) const;
+
+    /**
+     * @brief Walk resources/<limitKey>/<type> on the io pool, the limit key and type directories are listed in
+     * parallel and each type directory is passed to the callback as soon as it is listed
+     * @param resourcesDir the resources directory
+     * @param callback receives the type directories, from several threads at once
+     * @return false if a directory is invalid or the callback fails
+     */
+    bool ScanResources(const std::string &resourcesDir, DirectoryCallback callback) const;
 private:
+    bool ListResourceDir(const std::string &path, std::vector<FileEntry::DirEntry> &entries) const;
     bool ScanResourceLimitKeyDir(const std::string &resourceTypeDir, const std::string &limitKey,
-        std::function<bool(const DirectoryInfo&)> callback) const;
+        const DirectoryCallback &callback) const;
+    bool ScanResourceTypeDir(const DirectoryInfo &directoryInfo, const DirectoryCallback &callback) const;
 };
 }
 }
@@ -26,6 +26,7 @@ class ResourceItem {
 public:
     ResourceItem();
     ResourceItem(const ResourceItem &other);
+    ResourceItem(ResourceItem &&other) noexcept;
     ResourceItem(const std::string &name, const std::vector<KeyParam> &keyparams, ResType type);
     virtual ~ResourceItem();
 
@@ -50,9 +51,11 @@ public:
     void CheckData();
 
     ResourceItem &operator=(const ResourceItem &other);
+    ResourceItem &operator=(ResourceItem &&other) noexcept;
 private:
     void ReleaseData();
     void CopyFrom(const ResourceItem &other);
+    void MoveFrom(ResourceItem &other);
     int8_t *data_ = nullptr;
     uint32_t dataLen_ = 0;
     std::string name_;
@@ -16,6 +16,9 @@
 #ifndef OHOS_RESTOOL_RESOURCE_MODULE_H
 #define OHOS_RESTOOL_RESOURCE_MODULE_H
 
+#include <memory>
+#include "file_info_queue.h"
+#include "i_resource_compiler.h"
 #include "resource_item.h"
 #include "resource_directory.h"
 #include "resource_util.h"
@@ -28,6 +31,20 @@ public:
     ResourceModule(const std::string &modulePath, const std::string &moduleOutput, const std::string &moduleName);
     virtual ~ResourceModule() {};
     uint32_t ScanResource(bool isHap = false);
+
+    /**
+     * @brief Walk the module and compile its elements without ids, the modules may be parsed at the same time
+     * @param isHap whether the resources are scanned from a hap
+     * @return RESTOOL_SUCCESS if the walk and the elements succeed
+     */
+    uint32_t ParseResource(bool isHap = false);
+
+    /**
+     * @brief Generate the ids of the elements and compile the other types, the modules are committed one after
+     * another in the order of the inputs, as the ids and the duplicated files depend on the modules before
+     * @return RESTOOL_SUCCESS if all types are compiled
+     */
+    uint32_t CommitResource();
     const std::map<int64_t, std::vector<ResourceItem>> &GetOwner() const;
     const std::map<ResType, std::vector<DirectoryInfo>> &GetScanDirectorys() const;
     static uint32_t MergeResourceItem(std::map<int64_t, std::vector<ResourceItem>> &alls,
@@ -40,9 +57,18 @@ protected:
     std::map<int64_t, std::vector<ResourceItem>> owner_;
     std::map<ResType, std::vector<DirectoryInfo>> scanDirs_;
 private:
+    uint32_t WalkAndCompile(const std::vector<ResType> &types);
+    uint32_t CompileTypes(const std::vector<ResType> &types);
+    uint32_t CompileType(ResType type, std::unique_ptr<IResourceCompiler> &resourceCompiler);
+    uint32_t CommitTypes();
     void Push(const std::map<int64_t, std::vector<ResourceItem>> &other);
     static const std::vector<ResType> SCAN_SEQ;
     bool isHarResource_ = false;
+    bool isHap_ = false;
+    // the files of each type in SCAN_SEQ not compiled yet, filled by the walk
+    std::map<ResType, FileInfoQueue> queues_;
+    // the compilers whose ids are not generated yet
+    std::map<ResType, std::unique_ptr<IResourceCompiler>> compilers_;
 };
 }
 }
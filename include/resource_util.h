@@ -24,6 +24,8 @@
 namespace OHOS {
 namespace Global {
 namespace Restool {
+class IgnoreMatcher;
+
 class ResourceUtil {
 public:
     /**
@@ -152,6 +154,15 @@ public:
      */
     static bool IsIgnoreFile(const FileEntry &fileEntry);
 
+    /**
+     * @brief ignore file or directory
+     * @param fileName: the file name
+     * @param filePath: the file path
+     * @param isFile: whether it is a file or a directory
+     * @return true if ignore, other false
+     */
+    static bool IsIgnoreFile(const std::string &fileName, const std::string &filePath, bool isFile);
+
     /**
      * @brief generate hash string
      * @param key: string
@@ -301,6 +312,8 @@ public:
 
 private:
     static const std::map<std::string, IgnoreType> DEFAULT_IGNORE_FILE_REGEX;
+    static void ResetIgnoreMatcher();
+    static const IgnoreMatcher &GetIgnoreMatcher();
     static std::string GetLocaleLimitkey(const KeyParam &KeyParam);
     static std::string GetDeviceTypeLimitkey(const KeyParam &KeyParam);
     static std::string GetResolutionLimitkey(const KeyParam &KeyParam);
@@ -0,0 +1,60 @@
+/*
+ * Copyright (c) 2024 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef OHOS_RESTOOL_SHARDED_SET_H
+#define OHOS_RESTOOL_SHARDED_SET_H
+
+#include <array>
+#include <mutex>
+#include <string>
+#include <unordered_set>
+
+namespace OHOS {
+namespace Global {
+namespace Restool {
+// a set of strings split in shards by hash, each shard has its own lock so that the threads checking different
+// strings rarely wait on each other
+class ShardedSet {
+public:
+    /**
+     * @brief Insert a string
+     * @return false if the string is already in the set
+     */
+    bool Insert(const std::string &value);
+
+    /**
+     * @brief Erase a string
+     * @return true if the string was in the set
+     */
+    bool Erase(const std::string &value);
+
+private:
+    static constexpr size_t SHARD_COUNT = 64;
+    struct Shard {
+        std::mutex mutex;
+        std::unordered_set<std::string> values;
+    };
+    Shard &GetShard(const std::string &value);
+    std::array<Shard, SHARD_COUNT> shards_;
+};
+
+// the output paths of the resource files, shared by the compilers and the binary file packers
+extern ShardedSet g_resourceSet;
+// the output paths of the resources of the hap in overlap mode
+extern ShardedSet g_hapResourceSet;
+} // namespace Restool
+} // namespace Global
+} // namespace OHOS
+#endif
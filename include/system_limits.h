@@ -0,0 +1,54 @@
+/*
+ * Copyright (c) 2024 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef OHOS_RESTOOL_SYSTEM_LIMITS_H
+#define OHOS_RESTOOL_SYSTEM_LIMITS_H
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace OHOS {
+namespace Global {
+namespace Restool {
+class SystemLimits {
+public:
+    /**
+     * @brief Get the count of cpus the process may use, bounded by the cpu affinity and the cgroup cpu quota
+     * @return the count of cpus, 0 if unknown
+     */
+    static size_t GetCpuCount();
+
+    /**
+     * @brief Get the memory the process may use, bounded by the physical memory and the cgroup memory limit
+     * @return the limit in bytes, 0 if unknown
+     */
+    static uint64_t GetMemoryLimit();
+
+    /**
+     * @brief Get the budget of file bytes being copied or transcoded at the same time
+     */
+    static uint64_t GetInflightBytesBudget();
+
+private:
+    static size_t GetCgroupCpuQuota();
+    static uint64_t GetCgroupMemoryLimit();
+    static std::vector<std::string> GetCgroupDirs(const std::string &controller);
+    static bool ReadFirstLine(const std::string &path, std::string &line);
+};
+} // namespace Restool
+} // namespace Global
+} // namespace OHOS
+#endif
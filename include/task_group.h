@@ -0,0 +1,62 @@
+/*
+ * Copyright (c) 2024 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef OHOS_RESTOOL_TASK_GROUP_H
+#define OHOS_RESTOOL_TASK_GROUP_H
+
+#include <atomic>
+#include <functional>
+#include "no_copy_able.h"
+#include "thread_pool.h"
+
+namespace OHOS {
+namespace Global {
+namespace Restool {
+class TaskGroup : public NoCopyable {
+public:
+    explicit TaskGroup(TaskPriority priority = TaskPriority::HIGH, ThreadPool &pool = ThreadPool::GetInstance());
+    virtual ~TaskGroup();
+
+    /**
+     * @brief Spawn a task into the group, the first failed task cancels the group
+     * @param task the task to execute, returns RESTOOL_SUCCESS or RESTOOL_ERROR
+     */
+    void Spawn(std::function<uint32_t()> task);
+
+    /**
+     * @brief Wait for all spawned tasks
+     * @return RESTOOL_ERROR if any task failed or the group is cancelled
+     */
+    uint32_t Wait();
+
+    /**
+     * @brief Cancel the group, queued tasks are dropped and running tasks run to the end
+     */
+    void Cancel();
+
+    bool IsCancelled() const;
+
+private:
+    TaskPriority priority_;
+    ThreadPool &pool_;
+    // tasks are counted instead of keeping a future for each of them, so memory stays flat for huge groups
+    std::atomic<size_t> pendingTasks_{ 0 };
+    std::atomic<bool> cancelled_{ false };
+    std::atomic<bool> failed_{ false };
+};
+} // namespace Restool
+} // namespace Global
+} // namespace OHOS
+#endif
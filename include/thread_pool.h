@@ -16,11 +16,14 @@
 #ifndef OHOS_RESTOOL_THREAD_POOL_H
 #define OHOS_RESTOOL_THREAD_POOL_H
 
+#include <atomic>
+#include <chrono>
 #include <condition_variable>
+#include <deque>
 #include <functional>
 #include <future>
+#include <memory>
 #include <mutex>
-#include <queue>
 #include <string>
 #include <thread>
 #include <vector>
@@ -28,6 +31,13 @@
 namespace OHOS {
 namespace Global {
 namespace Restool {
+// HIGH is the critical path of the build, LOW is bulk background work such as copying rawfile
+enum class TaskPriority {
+    HIGH = 0,
+    LOW,
+    PRIORITY_COUNT,
+};
+
 class ThreadPool {
 public:
     ~ThreadPool();
@@ -43,6 +53,17 @@ public:
      */
     void Stop();
 
+    /**
+     * @brief Bound the count of queued tasks, 0 means unbounded
+     * @param highWaterMark above it a worker runs new tasks inline and other threads wait until tasks are taken
+     */
+    void SetHighWaterMark(size_t highWaterMark);
+
+    /**
+     * @brief Get the count of worker threads, 0 if the pool is not started
+     */
+    size_t GetThreadCount() const;
+
     /**
      * @brief Enqueue a task to queue of thread pool
      * @param f the function to execute
@@ -51,36 +72,144 @@ public:
     template <class F, class... Args>
     std::future<typename std::result_of<F(Args...)>::type> Enqueue(F &&f, Args &&...args);
 
+    /**
+     * @brief Enqueue a task to the lane of the priority
+     * @param priority the priority of the task
+     * @param f the function to execute
+     * @param args the args of the function
+     */
+    template <class F, class... Args>
+    std::future<typename std::result_of<F(Args...)>::type> Enqueue(TaskPriority priority, F &&f, Args &&...args);
+
+    /**
+     * @brief Get the result of a task of this pool, a worker thread runs queued tasks until the result is ready
+     * @param future the future returned by Enqueue
+     */
+    template <class T>
+    T Get(std::future<T> &future);
+
+    /**
+     * @brief Push a task without a future, for the callers tracking the completion by themselves
+     * @param priority the priority of the task
+     * @param task the function to execute
+     */
+    void Push(TaskPriority priority, std::function<void()> task);
+
+    /**
+     * @brief Wait until the condition is true, a worker thread runs queued tasks while waiting
+     * @param isReady the condition, rechecked whenever a task of this pool finishes
+     */
+    void WaitUntil(const std::function<bool()> &isReady);
+
+    /**
+     * @brief Run one queued task of the pool the calling thread is a worker of, for waits on other threads
+     * @return false if the caller is not a worker or there is no queued task
+     */
+    static bool RunPendingTaskOfCurrentPool();
+
+    /**
+     * @brief the pool for cpu bound work, such as compiling and transcoding
+     */
     static ThreadPool &GetInstance();
 
+    /**
+     * @brief the pool for io bound work, such as copying files and creating directories
+     */
+    static ThreadPool &GetIoInstance();
+
 private:
-    ThreadPool();
+    using Clock = std::chrono::steady_clock;
+
+    struct Task {
+        std::function<void()> func;
+        Clock::time_point enqueueTime;
+    };
+
+    // only written by the owner worker, read when the workers are joined
+    struct WorkerStatistics {
+        size_t taskCount = 0;
+        Clock::duration busyTime = Clock::duration::zero();
+        Clock::duration blockedTime = Clock::duration::zero();
+    };
+
+    // every worker owns a deque per lane, it pops the newest task from the back and others steal the oldest
+    // from the front
+    struct WorkQueue {
+        std::mutex mutex;
+        std::deque<Task> tasks[static_cast<size_t>(TaskPriority::PRIORITY_COUNT)];
+        size_t picks = 0;
+        WorkerStatistics statistics;
+    };
+
+    // upper bounds in microseconds of the queue wait histogram, the last bucket has no bound
+    static constexpr size_t WAIT_BUCKET_COUNT = 8;
+
+    explicit ThreadPool(const std::string &name);
     ThreadPool(const ThreadPool &) = delete;
     ThreadPool &operator=(const ThreadPool &) = delete;
-    void WorkInThread();
+    void WorkInThread(size_t index);
+    bool Take(size_t index, Task &task);
+    bool Pop(size_t index, size_t lane, Task &task);
+    bool Steal(size_t index, size_t lane, Task &task);
+    void Run(Task &task);
+    bool RunPendingTask();
+    void WaitForProgress(const std::function<bool()> &isReady, bool canHelp);
+    void NotifyHelpers();
+    void WaitForSpace();
+    void NotifyProducers();
+    void PrintStatistics() const;
+    std::string name_;
     std::vector<std::thread> workerThreads_;
-    std::queue<std::function<void()>> tasks_;
+    std::vector<std::unique_ptr<WorkQueue>> queues_;
+    std::atomic<size_t> nextQueue_{ 0 };
+    std::atomic<size_t> pendingTasks_{ 0 };
+    std::atomic<size_t> idleWorkers_{ 0 };
+    std::atomic<size_t> helpers_{ 0 };
+    std::atomic<size_t> producers_{ 0 };
+    size_t highWaterMark_ = 0;
+    std::atomic<size_t> peakPendingTasks_{ 0 };
+    std::atomic<size_t> inlineTasks_{ 0 };
+    std::atomic<size_t> waitHistogram_[WAIT_BUCKET_COUNT] = {};
+    Clock::time_point startTime_;
 
-    std::mutex queueMutex_;
+    std::mutex sleepMutex_;
     std::condition_variable condition_;
-    bool running_{ false };
+    std::condition_variable helperCondition_;
+    std::condition_variable spaceCondition_;
+    std::atomic<bool> running_{ false };
+
+    static thread_local ThreadPool *currentPool_;
+    static thread_local size_t currentIndex_;
+    static thread_local size_t runDepth_;
 };
 
 template <typename F, typename... Args>
 std::future<typename std::result_of<F(Args...)>::type> ThreadPool::Enqueue(F &&f, Args &&...args)
+{
+    return Enqueue(TaskPriority::HIGH, std::forward<F>(f), std::forward<Args>(args)...);
+}
+
+template <typename F, typename... Args>
+std::future<typename std::result_of<F(Args...)>::type> ThreadPool::Enqueue(TaskPriority priority, F &&f,
+    Args &&...args)
 {
     using return_type = typename std::result_of<F(Args...)>::type;
     using p_task = std::packaged_task<return_type()>;
     auto task = std::make_shared<p_task>(std::bind(std::forward<F>(f), std::forward<Args>(args)...));
 
     std::future<return_type> res = task->get_future();
-    {
-        std::unique_lock<std::mutex> lock(queueMutex_);
-        tasks_.emplace([task]() { (*task)(); });
-    }
-    condition_.notify_one();
+    Push(priority, [task]() { (*task)(); });
     return res;
 }
+
+template <class T>
+T ThreadPool::Get(std::future<T> &future)
+{
+    if (currentPool_ == this) {
+        WaitUntil([&future]() { return future.wait_for(std::chrono::seconds(0)) == std::future_status::ready; });
+    }
+    return future.get();
+}
 } // namespace Restool
 } // namespace Global
 } // namespace OHOS
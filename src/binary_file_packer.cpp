@@ -16,15 +16,35 @@
 #include "binary_file_packer.h"
 
 #include "compression_parser.h"
+#include "file_stat_cache.h"
 #include "restool_errors.h"
+#include "sharded_set.h"
 
 namespace OHOS {
 namespace Global {
 namespace Restool {
 using namespace std;
 
+namespace {
+// whether the files are output unchanged, without transcoding
+bool IsPlainCopy(const string &moduleName)
+{
+    auto compressionParser = CompressionParser::GetCompressionParser();
+    return moduleName == "har" || compressionParser->GetDefaultCompress() || !compressionParser->GetMediaSwitch();
+}
+
+// a plain copy waits on the disk and runs on the io pool, transcoding keeps a core busy and runs on the cpu pool
+ThreadPool &GetCopyPool(const string &moduleName)
+{
+    if (IsPlainCopy(moduleName)) {
+        return ThreadPool::GetIoInstance();
+    }
+    return ThreadPool::GetInstance();
+}
+}
+
 BinaryFilePacker::BinaryFilePacker(const PackageParser &packageParser, const std::string &moduleName)
-    : packageParser_(packageParser), moduleName_(moduleName)
+    : packageParser_(packageParser), moduleName_(moduleName), copyGroup_(TaskPriority::LOW, GetCopyPool(moduleName))
 {
 }
 
@@ -34,14 +54,14 @@ BinaryFilePacker::~BinaryFilePacker()
 
 void BinaryFilePacker::Terminate()
 {
-    terminate_.store(true);
+    copyGroup_.Cancel();
     GetResult();
 }
 
 uint32_t BinaryFilePacker::GetResult()
 {
     if (copyFuture_.valid()) {
-        result_ = copyFuture_.get();
+        result_ = ThreadPool::GetIoInstance().Get(copyFuture_);
     }
     return result_;
 }
@@ -49,7 +69,8 @@ uint32_t BinaryFilePacker::GetResult()
 void BinaryFilePacker::CopyBinaryFileAsync(const std::vector<std::string> &inputs)
 {
     auto func = [this](const vector<string> &inputs) { return this->CopyBinaryFile(inputs); };
-    copyFuture_ = ThreadPool::GetInstance().Enqueue(func, inputs);
+    // walking and copying rawfile is io bound and not on the critical path of the build
+    copyFuture_ = ThreadPool::GetIoInstance().Enqueue(TaskPriority::LOW, func, inputs);
 }
 
 uint32_t BinaryFilePacker::CopyBinaryFile(const vector<string> &inputs)
@@ -107,44 +128,63 @@ uint32_t BinaryFilePacker::CopyBinaryFileImpl(const string &src, const string &d
     if (!f.Init()) {
         return RESTOOL_ERROR;
     }
-    for (const auto &entry : f.GetChilds()) {
-        string filename = entry->GetFilePath().GetFilename();
-        if (ResourceUtil::IsIgnoreFile(*entry)) {
-            continue;
+    vector<FileEntry::DirEntry> entries;
+    FileEntry::FilePath srcPath(f.GetFilePath().GetPath());
+    FileEntry::ListDir(srcPath.GetPath(), entries);
+    // the copies query the sizes one by one on the pool, stat them in one batch while walking
+    vector<string> filePaths;
+    for (const auto &entry : entries) {
+        if (entry.isFile) {
+            filePaths.push_back(srcPath.Push(entry.name).GetPath());
+            srcPath.Pop();
         }
-
-        string subPath = FileEntry::FilePath(dst).Append(filename).GetPath();
-        if (!entry->IsFile()) {
-            if (CopyBinaryFileImpl(entry->GetFilePath().GetPath(), subPath) != RESTOOL_SUCCESS) {
-                return RESTOOL_ERROR;
-            }
-            continue;
+    }
+    FileStatCache::GetInstance().Prefetch(filePaths);
+    // the paths of the children are built in place, a string is only made for what a copy task keeps
+    FileEntry::FilePath dstPath(dst);
+    for (const auto &entry : entries) {
+        srcPath.Push(entry.name);
+        dstPath.Push(entry.name);
+        uint32_t result = CopyBinaryEntry(entry, srcPath.GetPath(), dstPath.GetPath());
+        srcPath.Pop();
+        dstPath.Pop();
+        if (result != RESTOOL_SUCCESS) {
+            return RESTOOL_ERROR;
         }
+    }
+    return RESTOOL_SUCCESS;
+}
 
-        if (IsDuplicated(entry, subPath)) {
-            continue;
-        }
+uint32_t BinaryFilePacker::CopyBinaryEntry(const FileEntry::DirEntry &entry, const string &path,
+    const string &subPath)
+{
+    if (ResourceUtil::IsIgnoreFile(entry.name, path, entry.isFile)) {
+        return RESTOOL_SUCCESS;
+    }
 
-        if (terminate_.load()) {
-            cout << "Info: CopyBinaryFileImpl: stop copy binary file." << endl;
-            return RESTOOL_ERROR;
-        }
+    if (!entry.isFile) {
+        return CopyBinaryFileImpl(path, subPath);
+    }
 
-        string path = entry->GetFilePath().GetPath();
-        auto copyFunc = [this](const string path, string subPath) { return this->CopySingleFile(path, subPath); };
-        std::future<uint32_t> res = ThreadPool::GetInstance().Enqueue(copyFunc, path, subPath);
-        copyResults_.push_back(std::move(res));
+    if (IsDuplicated(path, subPath)) {
+        return RESTOOL_SUCCESS;
+    }
+
+    if (copyGroup_.IsCancelled()) {
+        cout << "Info: CopyBinaryFileImpl: stop copy binary file." << endl;
+        return RESTOOL_ERROR;
     }
+
+    copyGroup_.Spawn([this, path = string(path), subPath = string(subPath)]() mutable {
+        return this->CopySingleFile(path, subPath);
+    });
     return RESTOOL_SUCCESS;
 }
 
-bool BinaryFilePacker::IsDuplicated(const unique_ptr<FileEntry> &entry, string subPath)
+bool BinaryFilePacker::IsDuplicated(const string &path, const string &subPath)
 {
-    lock_guard<mutex> lock(mutex_);
-    if (g_hapResourceSet.count(subPath)) {
-        g_hapResourceSet.erase(subPath);
-    } else if (!g_resourceSet.emplace(subPath).second) {
-        cout << "Warning: '" << entry->GetFilePath().GetPath() << "' is defined repeatedly." << endl;
+    if (!g_hapResourceSet.Erase(subPath) && !g_resourceSet.Insert(subPath)) {
+        cout << "Warning: '" << path << "' is defined repeatedly." << endl;
         return true;
     }
     return false;
@@ -152,33 +192,24 @@ bool BinaryFilePacker::IsDuplicated(const unique_ptr<FileEntry> &entry, string s
 
 uint32_t BinaryFilePacker::CopySingleFile(const std::string &path, std::string &subPath)
 {
-    if (terminate_.load()) {
-        cout << "Info: CopySingleFile: stop copy binary file." << endl;
-        return RESTOOL_ERROR;
-    }
-    if (moduleName_ == "har" || CompressionParser::GetCompressionParser()->GetDefaultCompress()) {
-        if (!ResourceUtil::CopyFileInner(path, subPath)) {
-            return RESTOOL_ERROR;
-        }
-        return RESTOOL_SUCCESS;
-    }
-    if (!CompressionParser::GetCompressionParser()->CopyAndTranscode(path, subPath, true)) {
-        return RESTOOL_ERROR;
-    }
-    return RESTOOL_SUCCESS;
+    bool result;
+    LinkMode linkMode = packageParser_.GetLinkMode();
+    if (linkMode != LinkMode::COPY && IsPlainCopy(moduleName_)) {
+        result = FileEntry::LinkFileInner(path, subPath, linkMode);
+    } else if (moduleName_ == "har" || CompressionParser::GetCompressionParser()->GetDefaultCompress()) {
+        result = ResourceUtil::CopyFileInner(path, subPath);
+    } else {
+        result = CompressionParser::GetCompressionParser()->CopyAndTranscode(path, subPath, true);
+    }
+    return result ? RESTOOL_SUCCESS : RESTOOL_ERROR;
 }
 
 uint32_t BinaryFilePacker::CheckCopyResults()
 {
-    for (auto &res : copyResults_) {
-        if (terminate_.load()) {
-            cout << "Info: CopyBinaryFile: stop copy binary file." << endl;
-            return RESTOOL_ERROR;
-        }
-        uint32_t ret = res.get();
-        if (ret != RESTOOL_SUCCESS) {
-            return RESTOOL_ERROR;
-        }
+    // the first failed copy cancels the group, the copies still queued are dropped
+    if (copyGroup_.Wait() != RESTOOL_SUCCESS) {
+        cout << "Info: CopyBinaryFile: stop copy binary file." << endl;
+        return RESTOOL_ERROR;
     }
     return RESTOOL_SUCCESS;
 }
@@ -0,0 +1,53 @@
+/*
+ * Copyright (c) 2024 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "byte_budget.h"
+
+namespace OHOS {
+namespace Global {
+namespace Restool {
+using namespace std;
+
+void ByteBudget::SetLimit(uint64_t limit)
+{
+    lock_guard<mutex> lock(mutex_);
+    limit_ = limit;
+    condition_.notify_all();
+}
+
+void ByteBudget::Acquire(uint64_t bytes)
+{
+    unique_lock<mutex> lock(mutex_);
+    uint64_t ticket = nextTicket_++;
+    condition_.wait(lock, [this, bytes, ticket]() {
+        return ticket == servingTicket_ && (limit_ == 0 || inflight_ == 0 || inflight_ + bytes <= limit_);
+    });
+    servingTicket_++;
+    inflight_ += bytes;
+    // the next caller in line may fit as well
+    condition_.notify_all();
+}
+
+void ByteBudget::Release(uint64_t bytes)
+{
+    {
+        lock_guard<mutex> lock(mutex_);
+        inflight_ -= bytes;
+    }
+    condition_.notify_all();
+}
+} // namespace Restool
+} // namespace Global
+} // namespace OHOS
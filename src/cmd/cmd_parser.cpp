@@ -116,6 +116,11 @@ void CmdParser::ShowUseage()
     std::cout << "    --ignored-file      Regular patterns of ignored files, split by ':'(like \\.git:\\.svn).\n";
     std::cout << "    --ignored-path      Regular patterns of ignored file paths, split by ':'";
     std::cout << "(like .+/rawfile/\\.git:.+/resfile/\\.svn).\n";
+    std::cout << "    --io-thread         Subthreads count for copying files, the same as '--thread' by default.\n";
+    std::cout << "    --link-mode         How rawfile and resfile are output, hardlink, symlink or copy(default).";
+    std::cout << " A file that can not be linked is copied.\n";
+    std::cout << "    --fadvise-threshold Size in MB from which the copied files are dropped from the page cache, ";
+    std::cout << DEFAULT_FADVISE_THRESHOLD_MB << " by default, 0 keeps all files cached.\n";
 }
 }
 }
@@ -16,6 +16,7 @@
 #include "cmd/package_parser.h"
 
 #include <algorithm>
+#include <cctype>
 #include <climits>
 #include <regex>
 #include <sstream>
@@ -54,6 +55,9 @@ const struct option PackageParser::CMD_OPTS[] = {
     { "thread", required_argument, nullptr, Option::THREAD},
     { "ignored-file", required_argument, nullptr, Option::IGNORED_FILE},
     { "ignored-path", required_argument, nullptr, Option::IGNORED_PATH},
+    { "io-thread", required_argument, nullptr, Option::IO_THREAD},
+    { "link-mode", required_argument, nullptr, Option::LINK_MODE},
+    { "fadvise-threshold", required_argument, nullptr, Option::FADVISE_THRESHOLD},
     { 0, 0, 0, 0},
 };
 
@@ -450,6 +454,16 @@ uint32_t PackageParser::ParseTargetConfig(const string &argValue)
 }
 
 uint32_t PackageParser::ParseThread(const std::string &argValue)
+{
+    return ParseThreadCount(argValue, threadCount_);
+}
+
+uint32_t PackageParser::ParseIoThread(const std::string &argValue)
+{
+    return ParseThreadCount(argValue, ioThreadCount_);
+}
+
+uint32_t PackageParser::ParseThreadCount(const std::string &argValue, size_t &threadCount)
 {
     if (argValue.empty()) {
         return RESTOOL_SUCCESS;
@@ -465,7 +479,7 @@ uint32_t PackageParser::ParseThread(const std::string &argValue)
         PrintError(GetError(ERR_CODE_INVALID_THREAD_COUNT).FormatCause(argValue.c_str()));
         return RESTOOL_ERROR;
     }
-    threadCount_ = static_cast<size_t>(count);
+    threadCount = static_cast<size_t>(count);
     return RESTOOL_SUCCESS;
 }
 
@@ -491,6 +505,51 @@ size_t PackageParser::GetThreadCount() const
     return threadCount_;
 }
 
+size_t PackageParser::GetIoThreadCount() const
+{
+    return ioThreadCount_;
+}
+
+uint32_t PackageParser::ParseLinkMode(const std::string &argValue)
+{
+    static const map<string, LinkMode> linkModes = {
+        { "copy", LinkMode::COPY },
+        { "hardlink", LinkMode::HARDLINK },
+        { "symlink", LinkMode::SYMLINK },
+    };
+    auto iter = linkModes.find(argValue);
+    if (iter == linkModes.end()) {
+        PrintError(GetError(ERR_CODE_INVALID_LINK_MODE).FormatCause(argValue.c_str()));
+        return RESTOOL_ERROR;
+    }
+    linkMode_ = iter->second;
+    return RESTOOL_SUCCESS;
+}
+
+LinkMode PackageParser::GetLinkMode() const
+{
+    return linkMode_;
+}
+
+uint32_t PackageParser::ParseFadviseThreshold(const std::string &argValue)
+{
+    char *end;
+    errno = 0;
+    unsigned long long threshold = strtoull(argValue.c_str(), &end, 10);
+    if (argValue.empty() || !isdigit(static_cast<unsigned char>(argValue[0])) || errno == ERANGE || *end != '\0' ||
+        threshold > UINT64_MAX / MB_SIZE) {
+        PrintError(GetError(ERR_CODE_INVALID_FADVISE_THRESHOLD).FormatCause(argValue.c_str()));
+        return RESTOOL_ERROR;
+    }
+    fadviseThreshold_ = threshold * MB_SIZE;
+    return RESTOOL_SUCCESS;
+}
+
+uint64_t PackageParser::GetFadviseThreshold() const
+{
+    return fadviseThreshold_;
+}
+
 bool PackageParser::IsAscii(const string& argValue) const
 {
 #ifdef __WIN32
@@ -553,6 +612,9 @@ void PackageParser::InitCommand()
     handles_.emplace(Option::THREAD, bind(&PackageParser::ParseThread, this, _1));
     handles_.emplace(Option::IGNORED_FILE, bind(&PackageParser::ParseIgnoreRegex, this, _1, "--ignored-file"));
     handles_.emplace(Option::IGNORED_PATH, bind(&PackageParser::ParseIgnoreRegex, this, _1, "--ignored-path"));
+    handles_.emplace(Option::IO_THREAD, bind(&PackageParser::ParseIoThread, this, _1));
+    handles_.emplace(Option::LINK_MODE, bind(&PackageParser::ParseLinkMode, this, _1));
+    handles_.emplace(Option::FADVISE_THRESHOLD, bind(&PackageParser::ParseFadviseThreshold, this, _1));
 }
 
 uint32_t PackageParser::HandleProcess(int c, const string &argValue)
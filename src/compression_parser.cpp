@@ -18,6 +18,9 @@
 #include <algorithm>
 #include <iostream>
 #include <mutex>
+#include "byte_budget.h"
+#include "file_entry.h"
+#include "file_stat_cache.h"
 #include "restool_errors.h"
 
 namespace OHOS {
@@ -375,6 +378,8 @@ TranscodeError CompressionParser::TranscodeImages(const string &imagePath, const
         return TranscodeError::LOAD_COMPRESS_FAILED;
     }
     TranscodeError ret = (*iTranscodeImages)(imagePath, extAppend, outputPath, result);
+    // the transcoder writes the output by itself, a failed transcode may have left a part of it
+    FileStatCache::GetInstance().Invalidate(outputPath);
     if (ret != TranscodeError::SUCCESS) {
         auto iter = ERRORCODEMAP.find(ret);
         if (iter != ERRORCODEMAP.end()) {
@@ -404,6 +409,7 @@ TranscodeError CompressionParser::ScaleImage(const std::string &imagePath, std::
         return TranscodeError::LOAD_COMPRESS_FAILED;
     }
     TranscodeError ret = (*iScaleImage)(imagePath, outputPath, { 512, 512 });
+    FileStatCache::GetInstance().Invalidate(outputPath);
     if (ret != TranscodeError::SUCCESS) {
         auto iter = ERRORCODEMAP.find(ret);
         if (iter != ERRORCODEMAP.end()) {
@@ -601,12 +607,16 @@ bool CompressionParser::CopyAndTranscode(const string &src, string &dst, const b
     if (!ResourceUtil::CreateDirs(output)) {
         return false;
     }
+    // the transcoder holds the image in memory, the copy that follows takes no budget of this file
+    uint64_t fileSize = FileEntry::GetFileSize(src);
+    ByteBudget::GetInstance().Acquire(fileSize);
     for (const auto &compressFilter : compressFilters_) {
         if (!CheckAndTranscode(src, dst, output, compressFilter, extAppend)) {
             continue;
         }
         break;
     }
+    ByteBudget::GetInstance().Release(fileSize);
     auto t2 = std::chrono::steady_clock::now();
     auto ret = CopyForTrans(src, originDst, dst);
     CollectTime(totalCounts_, totalTime_, t2);
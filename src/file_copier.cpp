@@ -0,0 +1,277 @@
+/*
+ * Copyright (c) 2024 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "file_copier.h"
+
+#include <cerrno>
+#include <climits>
+#include <cstdlib>
+#include <fstream>
+#include <memory>
+#ifndef _WIN32
+#include <unistd.h>
+#endif
+#ifdef __LINUX__
+#include <fcntl.h>
+#include <linux/fs.h>
+#include <sys/ioctl.h>
+#include <sys/sendfile.h>
+#include <sys/stat.h>
+#endif
+#include "byte_budget.h"
+
+namespace OHOS {
+namespace Global {
+namespace Restool {
+using namespace std;
+namespace {
+#ifdef __LINUX__
+constexpr size_t COPY_CHUNK_SIZE = 1 << 30;
+constexpr size_t BUFFER_SIZE = 1 << 20;
+
+// the errors of a method the file systems or the kernel do not support, the next method is tried
+bool IsUnsupported(int error)
+{
+    return error == ENOSYS || error == EXDEV || error == EINVAL || error == EOPNOTSUPP || error == ENOTSUP ||
+        error == ENOTTY;
+}
+
+bool IsEmpty(int fd)
+{
+    struct stat s;
+    return fstat(fd, &s) == 0 && s.st_size == 0;
+}
+
+class FileDescriptor {
+public:
+    explicit FileDescriptor(int fd) : fd_(fd) {}
+    ~FileDescriptor()
+    {
+        if (fd_ >= 0) {
+            close(fd_);
+        }
+    }
+    int Get() const
+    {
+        return fd_;
+    }
+    bool Close()
+    {
+        int fd = fd_;
+        fd_ = -1;
+        return close(fd) == 0;
+    }
+
+private:
+    int fd_;
+};
+#endif
+}
+
+atomic<uint64_t> FileCopier::copyCounts_[static_cast<size_t>(CopyMethod::COUNT)] = {};
+atomic<uint64_t> FileCopier::fadviseThreshold_{ DEFAULT_FADVISE_THRESHOLD_MB * MB_SIZE };
+
+bool FileCopier::Copy(const string &src, const string &dst)
+{
+#ifdef __LINUX__
+    FileDescriptor in(open(src.c_str(), O_RDONLY | O_CLOEXEC));
+    if (in.Get() < 0) {
+        return false;
+    }
+    FileDescriptor out(open(dst.c_str(), O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0666));
+    if (out.Get() < 0) {
+        return false;
+    }
+    uint64_t threshold = fadviseThreshold_.load(memory_order_relaxed);
+    struct stat s;
+    bool isBulk = threshold != 0 && fstat(in.Get(), &s) == 0 && static_cast<uint64_t>(s.st_size) >= threshold;
+    if (isBulk) {
+        // a larger readahead window, the advice is only a hint and its failure is ignored
+        posix_fadvise(in.Get(), 0, 0, POSIX_FADV_SEQUENTIAL);
+    }
+    using Method = CopyResult (*)(int, int);
+    const Method methods[] = { Reflink, CopyFileRange, SendFile, CopyBuffered };
+    for (size_t i = 0; i < sizeof(methods) / sizeof(methods[0]); ++i) {
+        CopyResult result = methods[i](in.Get(), out.Get());
+        if (result == CopyResult::UNSUPPORTED) {
+            continue;
+        }
+        if (result == CopyResult::FAILED) {
+            return false;
+        }
+        copyCounts_[i].fetch_add(1);
+        if (isBulk) {
+            DropCache(in.Get(), out.Get());
+        }
+        return out.Close();
+    }
+    return false;
+#else
+    ifstream in(src, ios::binary);
+    ofstream out(dst, ios::binary);
+    if (!in || !out) {
+        return false;
+    }
+    out << in.rdbuf();
+    copyCounts_[static_cast<size_t>(CopyMethod::BUFFERED)].fetch_add(1);
+    return true;
+#endif
+}
+
+bool FileCopier::LinkOrCopy(const string &src, const string &dst, LinkMode linkMode)
+{
+#ifndef _WIN32
+    if (linkMode != LinkMode::COPY) {
+        // a link does not replace an existing file, a stale output of an earlier build is dropped first
+        if (unlink(dst.c_str()) != 0 && errno != ENOENT) {
+            return false;
+        }
+        if (linkMode == LinkMode::HARDLINK && link(src.c_str(), dst.c_str()) == 0) {
+            copyCounts_[static_cast<size_t>(CopyMethod::HARDLINK)].fetch_add(1);
+            return true;
+        }
+        if (linkMode == LinkMode::SYMLINK) {
+            // a relative source would resolve against the output directory
+            char realPath[PATH_MAX];
+            if (realpath(src.c_str(), realPath) != nullptr && symlink(realPath, dst.c_str()) == 0) {
+                copyCounts_[static_cast<size_t>(CopyMethod::SYMLINK)].fetch_add(1);
+                return true;
+            }
+        }
+    }
+#endif
+    return Copy(src, dst);
+}
+
+void FileCopier::SetFadviseThreshold(uint64_t threshold)
+{
+    fadviseThreshold_.store(threshold, memory_order_relaxed);
+}
+
+string FileCopier::PrintCopyMessage()
+{
+    string res = "Copy report:\n";
+    res.append("reflink:").append(to_string(copyCounts_[static_cast<size_t>(CopyMethod::REFLINK)].load()))
+        .append(", copy_file_range:")
+        .append(to_string(copyCounts_[static_cast<size_t>(CopyMethod::COPY_FILE_RANGE)].load()))
+        .append(", sendfile:").append(to_string(copyCounts_[static_cast<size_t>(CopyMethod::SENDFILE)].load()))
+        .append(", buffered:").append(to_string(copyCounts_[static_cast<size_t>(CopyMethod::BUFFERED)].load()))
+        .append(", hardlink:").append(to_string(copyCounts_[static_cast<size_t>(CopyMethod::HARDLINK)].load()))
+        .append(", symlink:").append(to_string(copyCounts_[static_cast<size_t>(CopyMethod::SYMLINK)].load()))
+        .append(".");
+    return res;
+}
+
+#ifdef __LINUX__
+FileCopier::CopyResult FileCopier::Reflink(int in, int out)
+{
+#ifdef FICLONE
+    if (ioctl(out, FICLONE, in) == 0) {
+        return CopyResult::SUCCESS;
+    }
+    // a file system without reflink reports EOPNOTSUPP, two file systems EXDEV
+    return IsUnsupported(errno) || errno == EBADF || errno == EPERM ? CopyResult::UNSUPPORTED : CopyResult::FAILED;
+#else
+    return CopyResult::UNSUPPORTED;
+#endif
+}
+
+FileCopier::CopyResult FileCopier::CopyFileRange(int in, int out)
+{
+    bool copied = false;
+    while (true) {
+        ssize_t ret = copy_file_range(in, nullptr, out, nullptr, COPY_CHUNK_SIZE, 0);
+        if (ret > 0) {
+            copied = true;
+            continue;
+        }
+        if (ret == 0) {
+            // some kernels return 0 at once for the files of some file systems, leave them to the next method
+            return copied || IsEmpty(in) ? CopyResult::SUCCESS : CopyResult::UNSUPPORTED;
+        }
+        if (errno == EINTR) {
+            continue;
+        }
+        return !copied && IsUnsupported(errno) ? CopyResult::UNSUPPORTED : CopyResult::FAILED;
+    }
+}
+
+FileCopier::CopyResult FileCopier::SendFile(int in, int out)
+{
+    bool copied = false;
+    while (true) {
+        ssize_t ret = sendfile(out, in, nullptr, COPY_CHUNK_SIZE);
+        if (ret > 0) {
+            copied = true;
+            continue;
+        }
+        if (ret == 0) {
+            return copied || IsEmpty(in) ? CopyResult::SUCCESS : CopyResult::UNSUPPORTED;
+        }
+        if (errno == EINTR) {
+            continue;
+        }
+        return !copied && IsUnsupported(errno) ? CopyResult::UNSUPPORTED : CopyResult::FAILED;
+    }
+}
+
+FileCopier::CopyResult FileCopier::CopyBuffered(int in, int out)
+{
+    // the only copy holding the data in user space, the kernel copies take no budget
+    ByteBudget::GetInstance().Acquire(BUFFER_SIZE);
+    CopyResult result = CopyThroughBuffer(in, out);
+    ByteBudget::GetInstance().Release(BUFFER_SIZE);
+    return result;
+}
+
+FileCopier::CopyResult FileCopier::CopyThroughBuffer(int in, int out)
+{
+    unique_ptr<char[]> buffer = make_unique<char[]>(BUFFER_SIZE);
+    while (true) {
+        ssize_t readSize = read(in, buffer.get(), BUFFER_SIZE);
+        if (readSize == 0) {
+            return CopyResult::SUCCESS;
+        }
+        if (readSize < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            return CopyResult::FAILED;
+        }
+        ssize_t offset = 0;
+        while (offset < readSize) {
+            ssize_t writeSize = write(out, buffer.get() + offset, readSize - offset);
+            if (writeSize < 0) {
+                if (errno == EINTR) {
+                    continue;
+                }
+                return CopyResult::FAILED;
+            }
+            offset += writeSize;
+        }
+    }
+}
+
+void FileCopier::DropCache(int in, int out)
+{
+    posix_fadvise(in, 0, 0, POSIX_FADV_DONTNEED);
+    // dirty pages are not dropped, start their writeback first and wait for it so that the advice takes effect
+    sync_file_range(out, 0, 0, SYNC_FILE_RANGE_WAIT_BEFORE | SYNC_FILE_RANGE_WRITE | SYNC_FILE_RANGE_WAIT_AFTER);
+    posix_fadvise(out, 0, 0, POSIX_FADV_DONTNEED);
+}
+#endif
+} // namespace Restool
+} // namespace Global
+} // namespace OHOS
@@ -14,8 +14,8 @@
  */
 
 #include "file_entry.h"
+#include <cerrno>
 #include <cstring>
-#include <fstream>
 #include <iostream>
 #include "dirent.h"
 #include "sys/stat.h"
@@ -24,6 +24,8 @@
 #include "shlwapi.h"
 #include "windows.h"
 #endif
+#include "file_copier.h"
+#include "file_stat_cache.h"
 #include "resource_data.h"
 #include "restool_errors.h"
 
@@ -49,25 +51,40 @@ FileEntry::~FileEntry()
 bool FileEntry::Init()
 {
     string filePath = filePath_.GetPath();
-    if (!Exist(filePath)) {
+    FileStat stat = FileStatCache::GetInstance().Get(filePath);
+    if (!stat.exist) {
         cerr << "Warning: file not exist: " << filePath << endl;
         return false;
     }
 
-    isFile_ = !IsDirectory(filePath);
+    isFile_ = !stat.isDirectory;
     return true;
 }
 
 const vector<unique_ptr<FileEntry>> FileEntry::GetChilds() const
 {
     vector<unique_ptr<FileEntry>> children;
-    string filePath = filePath_.GetPath();
+    vector<DirEntry> entries;
+    if (!ListDir(filePath_.GetPath(), entries)) {
+        return children;
+    }
+    children.reserve(entries.size());
+    for (const auto &entry : entries) {
+        unique_ptr<FileEntry> f = make_unique<FileEntry>(filePath_.GetPath() + SEPARATE + entry.name);
+        f->isFile_ = entry.isFile;
+        children.push_back(move(f));
+    }
+    return children;
+}
+
+bool FileEntry::ListDir(const string &path, vector<DirEntry> &entries)
+{
 #ifdef _WIN32
     WIN32_FIND_DATA findData;
-    string temp(filePath + "\\*.*");
+    string temp(path + "\\*.*");
     HANDLE handle = FindFirstFile(AdaptLongPath(temp).c_str(), &findData);
     if (handle == INVALID_HANDLE_VALUE) {
-        return children;
+        return false;
     }
 
     do {
@@ -75,33 +92,37 @@ const vector<unique_ptr<FileEntry>> FileEntry::GetChilds() const
         if (IsIgnore(filename)) {
             continue;
         }
-
-        filePath = filePath_.GetPath() + SEPARATE + filename;
-        unique_ptr<FileEntry> f = make_unique<FileEntry>(filePath);
-        f->Init();
-        children.push_back(move(f));
+        entries.push_back({ filename, (findData.dwFileAttributes & FILE_ATTRIBUTE_DIRECTORY) == 0 });
     } while (FindNextFile(handle, &findData));
     FindClose(handle);
 #else
-    DIR *handle = opendir(filePath.c_str());
+    DIR *handle = opendir(path.c_str());
     if (handle == nullptr) {
-        return children;
+        return false;
     }
+    int dirFd = dirfd(handle);
     struct dirent *entry;
     while ((entry = readdir(handle)) != nullptr) {
         string filename(entry->d_name);
         if (IsIgnore(filename)) {
             continue;
         }
-
-        filePath = filePath_.GetPath() + SEPARATE + filename;
-        unique_ptr<FileEntry> f = make_unique<FileEntry>(filePath);
-        f->Init();
-        children.push_back(move(f));
+        bool isFile = entry->d_type != DT_DIR;
+        if (entry->d_type == DT_UNKNOWN || entry->d_type == DT_LNK) {
+            // follow the link as stat does, a dangling one is kept as a directory like FileEntry::Init leaves it
+            struct stat s;
+            if (fstatat(dirFd, entry->d_name, &s, 0) != 0) {
+                cerr << "Warning: file not exist: " << path << SEPARATE << filename << endl;
+                isFile = false;
+            } else {
+                isFile = !S_ISDIR(s.st_mode);
+            }
+        }
+        entries.push_back({ move(filename), isFile });
     }
     closedir(handle);
 #endif
-    return children;
+    return true;
 }
 
 bool FileEntry::IsFile() const
@@ -116,15 +137,7 @@ const FileEntry::FilePath &FileEntry::GetFilePath() const
 
 bool FileEntry::Exist(const string &path)
 {
-#ifdef _WIN32
-    return PathFileExists(AdaptLongPath(path).c_str());
-#else
-    struct stat s;
-    if (stat(path.c_str(), &s) != 0) {
-        return false;
-    }
-#endif
-    return true;
+    return FileStatCache::GetInstance().Get(path).exist;
 }
 
 bool FileEntry::RemoveAllDir(const string &path)
@@ -138,7 +151,9 @@ bool FileEntry::RemoveAllDir(const string &path)
         PrintError(GetError(ERR_CODE_REMOVE_FILE_ERROR).FormatCause(path.c_str(), "not directory"));
         return false;
     }
-    return RemoveAllDirInner(f);
+    bool result = RemoveAllDirInner(f);
+    FileStatCache::GetInstance().Clear();
+    return result;
 }
 
 bool FileEntry::RemoveFile(const string &path)
@@ -147,7 +162,9 @@ bool FileEntry::RemoveFile(const string &path)
     if (!f.Init()) {
         return false;
     }
-    return RemoveAllDirInner(f);
+    bool result = RemoveAllDirInner(f);
+    FileStatCache::GetInstance().Clear();
+    return result;
 }
 
 bool FileEntry::CreateDirs(const string &path)
@@ -163,33 +180,40 @@ bool FileEntry::CopyFileInner(const string &src, const string &dst)
         return false;
     }
 #else
-    ifstream in(src, ios::binary);
-    ofstream out(dst, ios::binary);
-    if (!in || !out) {
+    if (!FileCopier::Copy(src, dst)) {
         PrintError(GetError(ERR_CODE_COPY_FILE_ERROR).FormatCause(src.c_str(), dst.c_str(), strerror(errno)));
         return false;
     }
-    out << in.rdbuf();
 #endif
+    FileStatCache::GetInstance().Invalidate(dst);
     return true;
 }
 
-bool FileEntry::IsDirectory(const string &path)
+bool FileEntry::LinkFileInner(const string &src, const string &dst, LinkMode linkMode)
 {
 #ifdef _WIN32
-    if (!PathIsDirectory(AdaptLongPath(path).c_str())) {
-        return false;
-    }
-    return true;
+    return CopyFileInner(src, dst);
 #else
-    struct stat s;
-    if (stat(path.c_str(), &s) != 0) {
+    if (!FileCopier::LinkOrCopy(src, dst, linkMode)) {
+        PrintError(GetError(ERR_CODE_COPY_FILE_ERROR).FormatCause(src.c_str(), dst.c_str(), strerror(errno)));
         return false;
     }
-    return S_ISDIR(s.st_mode);
+    FileStatCache::GetInstance().Invalidate(dst);
+    return true;
 #endif
 }
 
+bool FileEntry::IsDirectory(const string &path)
+{
+    FileStat stat = FileStatCache::GetInstance().Get(path);
+    return stat.exist && stat.isDirectory;
+}
+
+uint64_t FileEntry::GetFileSize(const string &path)
+{
+    return FileStatCache::GetInstance().Get(path).size;
+}
+
 string FileEntry::RealPath(const string &path)
 {
 #ifdef _WIN32
@@ -231,31 +255,59 @@ FileEntry::FilePath::FilePath(const string &path) : filePath_(path)
     Init();
 }
 
+FileEntry::FilePath::FilePath(string &&path) : filePath_(move(path))
+{
+    Format();
+    Init();
+}
+
 FileEntry::FilePath::~FilePath()
 {
 }
 
 FileEntry::FilePath FileEntry::FilePath::Append(const string &path)
 {
-    Format();
-    string filePath = filePath_ + SEPARATE + path;
-    return FilePath(filePath);
+    if (Format()) {
+        Init();
+    }
+    string filePath;
+    filePath.reserve(filePath_.length() + SEPARATE.length() + path.length());
+    filePath.append(filePath_).append(SEPARATE).append(path);
+    return FilePath(move(filePath));
 }
 
 FileEntry::FilePath FileEntry::FilePath::ReplaceExtension(const string &extension)
 {
     string filePath;
-    if (!parent_.empty()) {
-        filePath += parent_ + SEPARATE;
+    if (parentEnd_ != string::npos && parentEnd_ != 0) {
+        filePath.append(GetParentPath()).append(SEPARATE);
     }
 
-    filePath += filename_.substr(0, filename_.length() - extension_.length()) + extension;
-    return FilePath(filePath);
+    string_view filename = GetFilename();
+    filePath.append(filename.substr(0, filename.length() - GetExtension().length())).append(extension);
+    return FilePath(move(filePath));
 }
 
 FileEntry::FilePath FileEntry::FilePath::GetParent()
 {
-    return FilePath(parent_);
+    return FilePath(string(GetParentPath()));
+}
+
+FileEntry::FilePath &FileEntry::FilePath::Push(string_view path)
+{
+    Format();
+    filePath_.append(SEPARATE).append(path);
+    Format();
+    Init();
+    return *this;
+}
+
+FileEntry::FilePath &FileEntry::FilePath::Pop()
+{
+    filePath_.resize(parentEnd_ == string::npos ? 0 : parentEnd_);
+    Format();
+    Init();
+    return *this;
 }
 
 const string &FileEntry::FilePath::GetPath() const
@@ -263,14 +315,41 @@ const string &FileEntry::FilePath::GetPath() const
     return filePath_;
 }
 
-const string &FileEntry::FilePath::GetFilename() const
+string_view FileEntry::FilePath::GetParentPath() const
 {
-    return filename_;
+    if (parentEnd_ == string::npos) {
+        return string_view();
+    }
+    return string_view(filePath_).substr(0, parentEnd_);
+}
+
+string_view FileEntry::FilePath::GetFilename() const
+{
+    return string_view(filePath_).substr(filenamePos_);
 }
 
-const string &FileEntry::FilePath::GetExtension() const
+string_view FileEntry::FilePath::GetExtension() const
 {
-    return extension_;
+    if (extensionPos_ == string::npos) {
+        return string_view();
+    }
+    return string_view(filePath_).substr(extensionPos_);
+}
+
+string_view FileEntry::FilePath::GetExtension(string_view path)
+{
+    if (!path.empty() && path.back() == SEPARATE.front()) {
+        path.remove_suffix(1);
+    }
+    string_view::size_type pos = path.find_last_of(SEPARATE.front());
+    if (pos != string_view::npos && pos + 1 < path.length()) {
+        path.remove_prefix(pos + 1);
+    }
+    pos = path.find_last_of('.');
+    if (pos != string_view::npos && pos + 1 < path.length()) {
+        return path.substr(pos);
+    }
+    return string_view();
 }
 
 const vector<string> FileEntry::FilePath::GetSegments() const
@@ -291,7 +370,7 @@ const vector<string> FileEntry::FilePath::GetSegments() const
 }
 
 // below private
-bool FileEntry::IsIgnore(const string &filename) const
+bool FileEntry::IsIgnore(const string &filename)
 {
     if (filename == "." || filename == "..") {
         return true;
@@ -339,48 +418,62 @@ bool FileEntry::CreateDirsInner(const string &path, string::size_type offset)
 {
     string::size_type pos = path.find_first_of(SEPARATE.front(), offset);
     if (pos == string::npos) {
-#ifdef _WIN32
-        return CreateDirectory(AdaptLongPath(path).c_str(), nullptr) != 0;
-#else
-        return mkdir(path.c_str(), S_IRWXU | S_IRGRP | S_IXGRP | S_IROTH | S_IXOTH) == 0;
-#endif
+        return MakeDir(path);
     }
 
     string subPath = path.substr(0, pos + 1);
-    if (!Exist(subPath)) {
+    if (!Exist(subPath) && !MakeDir(subPath)) {
+        return false;
+    }
+    return CreateDirsInner(path, pos + 1);
+}
+
+bool FileEntry::MakeDir(const string &path)
+{
+    // threads creating the output folders may race on a common parent, losing the race is not an error
 #ifdef _WIN32
-        if (!CreateDirectory(AdaptLongPath(subPath).c_str(), nullptr)) {
+    if (CreateDirectory(AdaptLongPath(path).c_str(), nullptr)) {
+        return true;
+    }
+    bool exist = GetLastError() == ERROR_ALREADY_EXISTS;
 #else
-        if (mkdir(subPath.c_str(), S_IRWXU | S_IRGRP | S_IXGRP | S_IROTH | S_IXOTH) != 0) {
+    if (mkdir(path.c_str(), S_IRWXU | S_IRGRP | S_IXGRP | S_IROTH | S_IXOTH) == 0) {
+        return true;
+    }
+    bool exist = errno == EEXIST;
 #endif
-            return false;
-        }
+    if (!exist) {
+        return false;
     }
-    return CreateDirsInner(path, pos + 1);
+    if (IsDirectory(path)) {
+        return true;
+    }
+    // a file is in the way, report it rather than the errno of the stat
+    errno = EEXIST;
+    return false;
 }
 
-void FileEntry::FilePath::Format()
+bool FileEntry::FilePath::Format()
 {
-    if (filePath_.back() != SEPARATE.front()) {
-        return;
+    if (filePath_.empty() || filePath_.back() != SEPARATE.front()) {
+        return false;
     }
     filePath_.pop_back();
+    return true;
 }
 
 void FileEntry::FilePath::Init()
 {
-    filename_ = filePath_;
-    string::size_type pos = filePath_.find_last_of(SEPARATE.front());
-    if (pos != string::npos) {
-        parent_ = filePath_.substr(0, pos);
-        if (pos + 1 < filePath_.length()) {
-            filename_ = filePath_.substr(pos + 1);
-        }
+    // a path ending with a separator after Format is its own filename, as "a/" of "a//"
+    parentEnd_ = filePath_.find_last_of(SEPARATE.front());
+    filenamePos_ = 0;
+    if (parentEnd_ != string::npos && parentEnd_ + 1 < filePath_.length()) {
+        filenamePos_ = parentEnd_ + 1;
     }
 
-    pos = filename_.find_last_of('.');
-    if (pos != string::npos && pos + 1 < filename_.length()) {
-        extension_ = filename_.substr(pos);
+    extensionPos_ = filePath_.find_last_of('.');
+    if (extensionPos_ == string::npos || extensionPos_ < filenamePos_ || extensionPos_ + 1 >= filePath_.length()) {
+        extensionPos_ = string::npos;
     }
 }
 
@@ -0,0 +1,91 @@
+/*
+ * Copyright (c) 2024 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "file_info_queue.h"
+#include "thread_pool.h"
+
+namespace OHOS {
+namespace Global {
+namespace Restool {
+using namespace std;
+
+void FileInfoQueue::Push(vector<FileInfo> &&fileInfos)
+{
+    {
+        lock_guard<mutex> lock(mutex_);
+        batches_.push_back(move(fileInfos));
+        pushed_ = true;
+    }
+    condition_.notify_all();
+}
+
+void FileInfoQueue::Close()
+{
+    {
+        lock_guard<mutex> lock(mutex_);
+        closed_ = true;
+    }
+    condition_.notify_all();
+}
+
+void FileInfoQueue::Cancel()
+{
+    {
+        lock_guard<mutex> lock(mutex_);
+        closed_ = true;
+        cancelled_ = true;
+    }
+    condition_.notify_all();
+}
+
+bool FileInfoQueue::Pop(vector<FileInfo> &fileInfos)
+{
+    unique_lock<mutex> lock(mutex_);
+    WaitFor(lock, [this]() { return closed_ || !batches_.empty(); });
+    if (cancelled_ || batches_.empty()) {
+        return false;
+    }
+    fileInfos = move(batches_.front());
+    batches_.pop_front();
+    return true;
+}
+
+bool FileInfoQueue::WaitFirst()
+{
+    unique_lock<mutex> lock(mutex_);
+    WaitFor(lock, [this]() { return closed_ || pushed_; });
+    return pushed_;
+}
+
+void FileInfoQueue::WaitFor(unique_lock<mutex> &lock, const function<bool()> &isReady)
+{
+    while (!isReady()) {
+        lock.unlock();
+        bool helped = ThreadPool::RunPendingTaskOfCurrentPool();
+        lock.lock();
+        if (!helped) {
+            condition_.wait(lock, isReady);
+        }
+    }
+}
+
+bool FileInfoQueue::IsCancelled()
+{
+    lock_guard<mutex> lock(mutex_);
+    return cancelled_;
+}
+} // namespace Restool
+} // namespace Global
+} // namespace OHOS
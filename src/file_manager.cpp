@@ -15,16 +15,20 @@
 
 #include "file_manager.h"
 #include <algorithm>
+#include <atomic>
 #include "compression_parser.h"
 #include <iostream>
+#include <memory>
 #include "resource_compiler_factory.h"
 #include "file_entry.h"
 #include "key_parser.h"
+#include "parallel_algorithm.h"
 #include "reference_parser.h"
 #include "resource_directory.h"
 #include "resource_util.h"
 #include "restool_errors.h"
 #include "resource_module.h"
+#include "thread_pool.h"
 
 namespace OHOS {
 namespace Global {
@@ -32,13 +36,41 @@ namespace Restool {
 using namespace std;
 uint32_t FileManager::ScanModules(const vector<string> &inputs, const string &output, const bool isHar)
 {
+    // the modules are walked and their elements parsed at the same time, the ids, the duplicated files and the
+    // merge depend on the modules before and are committed one module after another in the order of the inputs
+    vector<unique_ptr<ResourceModule>> modules;
+    for (const auto &input : inputs) {
+        modules.push_back(make_unique<ResourceModule>(input, output, moduleName_));
+    }
+    ThreadPool &pool = ThreadPool::GetInstance();
+    atomic<bool> cancelled(false);
+    vector<future<uint32_t>> futures;
+    for (auto &module : modules) {
+        // the first module depends on no other, it is scanned completely and its commit only merges
+        bool isFirst = futures.empty();
+        futures.push_back(pool.Enqueue(TaskPriority::HIGH, [this, &module, &cancelled, isFirst]() {
+            if (cancelled) {
+                return RESTOOL_ERROR;
+            }
+            return isFirst ? module->ScanResource(scanHap_) : module->ParseResource(scanHap_);
+        }));
+    }
+
     vector<pair<ResType, string>> noBaseResource;
-    for (auto input : inputs) {
-        if (ScanModule(input, output) != RESTOOL_SUCCESS) {
-            return RESTOOL_ERROR;
+    uint32_t result = RESTOOL_SUCCESS;
+    for (size_t i = 0; i < modules.size(); i++) {
+        // the parses still queued refer to the modules, they are skipped but waited for after an error
+        if (pool.Get(futures[i]) != RESTOOL_SUCCESS || result != RESTOOL_SUCCESS ||
+            CommitModule(*modules[i]) != RESTOOL_SUCCESS) {
+            result = RESTOOL_ERROR;
+            cancelled = true;
+            continue;
         }
         CheckAllItems(noBaseResource);
     }
+    if (result != RESTOOL_SUCCESS) {
+        return RESTOOL_ERROR;
+    }
     if (!noBaseResource.empty()) {
         ResourceUtil::PrintWarningMsg(noBaseResource);
     }
@@ -51,10 +83,9 @@ uint32_t FileManager::MergeResourceItem(const map<int64_t, vector<ResourceItem>>
 }
 
 // below private founction
-uint32_t FileManager::ScanModule(const string &input, const string &output)
+uint32_t FileManager::CommitModule(ResourceModule &resourceModule)
 {
-    ResourceModule resourceModule(input, output, moduleName_);
-    if (resourceModule.ScanResource(scanHap_) != RESTOOL_SUCCESS) {
+    if (resourceModule.CommitResource() != RESTOOL_SUCCESS) {
         return RESTOOL_ERROR;
     }
     MergeResourceItem(resourceModule.GetOwner());
@@ -72,21 +103,33 @@ uint32_t FileManager::ParseReference(const string &output)
 
 void FileManager::CheckAllItems(vector<pair<ResType, string>> &noBaseResource)
 {
+    vector<const vector<ResourceItem> *> itemLists;
+    itemLists.reserve(items_.size());
     for (const auto &item : items_) {
-        bool found = any_of(item.second.begin(), item.second.end(), [](const auto &iter) {
-            return iter.GetLimitKey() == "base";
-        });
-        if (!found) {
-            auto firstItem = item.second.front();
-            bool ret = any_of(noBaseResource.begin(), noBaseResource.end(), [firstItem](const auto &iterItem) {
-                return (firstItem.GetResType() == iterItem.first)  &&
-                    (firstItem.GetName() == iterItem.second);
-            });
-            if (!ret) {
-                noBaseResource.push_back(make_pair(firstItem.GetResType(), firstItem.GetName()));
-            }
-        }
+        itemLists.push_back(&item.second);
     }
+    using NoBaseResource = vector<pair<ResType, string>>;
+    ParallelReduce(itemLists.size(), noBaseResource,
+        [&itemLists](size_t begin, size_t end, NoBaseResource &partial) {
+            for (size_t i = begin; i < end; ++i) {
+                const auto &resourceItems = *itemLists[i];
+                bool found = any_of(resourceItems.begin(), resourceItems.end(), [](const auto &iter) {
+                    return iter.GetLimitKey() == "base";
+                });
+                if (!found) {
+                    const auto &firstItem = resourceItems.front();
+                    partial.push_back(make_pair(firstItem.GetResType(), firstItem.GetName()));
+                }
+            }
+            return RESTOOL_SUCCESS;
+        },
+        [](NoBaseResource &result, NoBaseResource &partial) {
+            for (auto &resource : partial) {
+                if (find(result.begin(), result.end(), resource) == result.end()) {
+                    result.push_back(std::move(resource));
+                }
+            }
+        });
 }
 
 bool FileManager::ScaleIcons(const string &output, const std::map<std::string, std::set<uint32_t>> &iconMap)
@@ -161,7 +204,7 @@ bool FileManager::ScaleIcon(const string &output, ResourceItem &item)
     if (!CompressionParser::GetCompressionParser()->CopyAndTranscode(scaleDst, dst)) {
         return false;
     }
-    string newFileName = FileEntry::FilePath(dst).GetFilename();
+    string newFileName(FileEntry::FilePath(dst).GetFilename());
     std::string newData = moduleName_ + SEPARATOR + RESOURCES_DIR + SEPARATOR + item.GetLimitKey() + SEPARATOR + media
         + SEPARATOR + newFileName;
     if (!item.SetData(reinterpret_cast<const int8_t *>(newData.c_str()), newData.length())) {
@@ -0,0 +1,134 @@
+/*
+ * Copyright (c) 2024 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "file_stat_cache.h"
+
+#include <functional>
+#include "sys/stat.h"
+#ifdef _WIN32
+#include "windows.h"
+#endif
+#include "file_entry.h"
+
+namespace OHOS {
+namespace Global {
+namespace Restool {
+using namespace std;
+
+FileStat FileStatCache::Get(const string &path)
+{
+    Shard &shard = GetShard(path);
+    uint64_t version = 0;
+    {
+        lock_guard<mutex> lock(shard.mutex);
+        auto iter = shard.stats.find(path);
+        if (iter != shard.stats.end()) {
+            return iter->second;
+        }
+        version = shard.version;
+    }
+    // stat outside the lock, two threads racing on the same path both store the same result. A path written or
+    // removed during the stat may have been stat'ed before the change, the result is returned but not cached.
+    FileStat stat = Stat(path);
+    if (stat.exist) {
+        lock_guard<mutex> lock(shard.mutex);
+        if (shard.version == version) {
+            shard.stats[path] = stat;
+        }
+    }
+    return stat;
+}
+
+void FileStatCache::Prefetch(const vector<string> &paths)
+{
+    vector<string> missing;
+    vector<uint64_t> versions;
+    for (const auto &path : paths) {
+        Shard &shard = GetShard(path);
+        lock_guard<mutex> lock(shard.mutex);
+        if (shard.stats.find(path) == shard.stats.end()) {
+            missing.push_back(path);
+            versions.push_back(shard.version);
+        }
+    }
+    for (size_t i = 0; i < missing.size(); i++) {
+        FileStat stat = Stat(missing[i]);
+        if (!stat.exist) {
+            continue;
+        }
+        Shard &shard = GetShard(missing[i]);
+        lock_guard<mutex> lock(shard.mutex);
+        if (shard.version == versions[i]) {
+            shard.stats[missing[i]] = stat;
+        }
+    }
+}
+
+void FileStatCache::Invalidate(const string &path)
+{
+    Shard &shard = GetShard(path);
+    lock_guard<mutex> lock(shard.mutex);
+    shard.stats.erase(path);
+    shard.version++;
+}
+
+void FileStatCache::Clear()
+{
+    for (auto &shard : shards_) {
+        lock_guard<mutex> lock(shard.mutex);
+        shard.stats.clear();
+        shard.version++;
+    }
+    generation_.fetch_add(1);
+}
+
+uint64_t FileStatCache::GetGeneration() const
+{
+    return generation_.load();
+}
+
+FileStat FileStatCache::Stat(const string &path)
+{
+    FileStat stat;
+#ifdef _WIN32
+    WIN32_FILE_ATTRIBUTE_DATA data;
+    if (!GetFileAttributesExA(FileEntry::AdaptLongPath(path).c_str(), GetFileExInfoStandard, &data)) {
+        return stat;
+    }
+    stat.exist = true;
+    stat.isDirectory = (data.dwFileAttributes & FILE_ATTRIBUTE_DIRECTORY) != 0;
+    stat.size = (static_cast<uint64_t>(data.nFileSizeHigh) << 32) | data.nFileSizeLow;
+    stat.mtime = static_cast<int64_t>((static_cast<uint64_t>(data.ftLastWriteTime.dwHighDateTime) << 32) |
+        data.ftLastWriteTime.dwLowDateTime);
+#else
+    struct stat s;
+    if (::stat(path.c_str(), &s) != 0) {
+        return stat;
+    }
+    stat.exist = true;
+    stat.isDirectory = S_ISDIR(s.st_mode);
+    stat.size = static_cast<uint64_t>(s.st_size);
+    stat.mtime = static_cast<int64_t>(s.st_mtime);
+#endif
+    return stat;
+}
+
+FileStatCache::Shard &FileStatCache::GetShard(const string &path)
+{
+    return shards_[hash<string>()(path) % SHARD_COUNT];
+}
+} // namespace Restool
+} // namespace Global
+} // namespace OHOS
@@ -15,14 +15,19 @@
 
 #include "generic_compiler.h"
 
+#include <algorithm>
+#include <deque>
 #include <iostream>
+#include <list>
+#include <set>
 
 #include "compression_parser.h"
 #include "file_entry.h"
 #include "id_worker.h"
 #include "resource_util.h"
 #include "restool_errors.h"
-#include "thread_pool.h"
+#include "sharded_set.h"
+#include "task_group.h"
 
 namespace OHOS {
 namespace Global {
@@ -37,16 +42,48 @@ GenericCompiler::~GenericCompiler()
 {
 }
 
-uint32_t GenericCompiler::CompileFiles(const std::vector<FileInfo> &fileInfos)
+uint32_t GenericCompiler::CompileStream(FileInfoQueue &queue)
 {
     cout << "Info: GenericCompiler::CompileFiles" << endl;
-    std::vector<std::future<uint32_t>> results;
-    for (const auto &fileInfo : fileInfos) {
-        auto taskFunc = [this](const FileInfo &fileInfo) { return this->CompileSingleFile(fileInfo); };
-        results.push_back(ThreadPool::GetInstance().Enqueue(taskFunc, fileInfo));
+    // the files of a directory are copied as soon as the walker lists it, the duplicated ones are dropped and the
+    // few output folders are created before the copy tasks are spawned, the batches outlive the tasks
+    list<vector<FileInfo>> batches;
+    set<string> outputFolders;
+    // each copy task fills its own item, the items are merged once all copies are done, so the tasks share no lock
+    deque<pair<const FileInfo *, ResourceItem>> results;
+    // a plain copy waits on the disk and runs on the io pool, only the transcodes need the cpu pool
+    TaskGroup taskGroup(TaskPriority::HIGH, IsPlainCopy() ? ThreadPool::GetIoInstance() : ThreadPool::GetInstance());
+    vector<FileInfo> batch;
+    while (queue.Pop(batch)) {
+        batches.push_back(move(batch));
+        for (const auto &fileInfo : batches.back()) {
+            if (IsIgnore(fileInfo)) {
+                continue;
+            }
+            string outputFolder = GetOutputFolder(fileInfo);
+            if (outputFolders.insert(outputFolder).second && !ResourceUtil::CreateDirs(outputFolder)) {
+                return RESTOOL_ERROR;
+            }
+            results.emplace_back(&fileInfo, ResourceItem());
+            auto result = &results.back();
+            taskGroup.Spawn([this, result]() { return this->CompileMediaFile(*result->first, result->second); });
+        }
+    }
+    if (queue.IsCancelled() || taskGroup.Wait() != RESTOOL_SUCCESS) {
+        return RESTOOL_ERROR;
     }
-    for (auto &ret : results) {
-        if (ret.get() != RESTOOL_SUCCESS) {
+
+    // the directories are listed in any order, the items are merged in the order of the paths
+    vector<const pair<const FileInfo *, ResourceItem> *> sortedResults;
+    sortedResults.reserve(results.size());
+    for (const auto &result : results) {
+        sortedResults.push_back(&result);
+    }
+    sort(sortedResults.begin(), sortedResults.end(), [](const auto a, const auto b) {
+        return a->first->filePath < b->first->filePath;
+    });
+    for (const auto result : sortedResults) {
+        if (!MergeResourceItem(result->second)) {
             return RESTOOL_ERROR;
         }
     }
@@ -58,22 +95,30 @@ uint32_t GenericCompiler::CompileSingleFile(const FileInfo &fileInfo)
     if (IsIgnore(fileInfo)) {
         return RESTOOL_SUCCESS;
     }
+    ResourceItem resourceItem;
+    if (CompileMediaFile(fileInfo, resourceItem) != RESTOOL_SUCCESS) {
+        return RESTOOL_ERROR;
+    }
+    return MergeResourceItem(resourceItem) ? RESTOOL_SUCCESS : RESTOOL_ERROR;
+}
 
+uint32_t GenericCompiler::CompileMediaFile(const FileInfo &fileInfo, ResourceItem &resourceItem)
+{
     string output = "";
     if (!CopyMediaFile(fileInfo, output)) {
         return RESTOOL_ERROR;
     }
 
-    if (!PostMediaFile(fileInfo, output)) {
+    if (!PostMediaFile(fileInfo, output, resourceItem)) {
         return RESTOOL_ERROR;
     }
     return RESTOOL_SUCCESS;
 }
 
-bool GenericCompiler::PostMediaFile(const FileInfo &fileInfo, const std::string &output)
+bool GenericCompiler::PostMediaFile(const FileInfo &fileInfo, const std::string &output,
+    ResourceItem &resourceItem) const
 {
-    std::lock_guard<std::mutex> lock(mutex_);
-    ResourceItem resourceItem(fileInfo.filename, fileInfo.keyParams, type_);
+    resourceItem = ResourceItem(fileInfo.filename, fileInfo.keyParams, type_);
     resourceItem.SetFilePath(fileInfo.filePath);
     resourceItem.SetLimitKey(fileInfo.limitKey);
 
@@ -94,24 +139,19 @@ bool GenericCompiler::PostMediaFile(const FileInfo &fileInfo, const std::string
     if (isOverlap_) {
         resourceItem.MarkCoverable();
     }
-
-    return MergeResourceItem(resourceItem);
+    return true;
 }
 
 string GenericCompiler::GetOutputFilePath(const FileInfo &fileInfo) const
 {
-    string outputFolder = GetOutputFolder(fileInfo);
-    string outputFilePath = FileEntry::FilePath(outputFolder).Append(fileInfo.filename).GetPath();
-    return outputFilePath;
+    FileEntry::FilePath outputFilePath(GetOutputFolder(fileInfo));
+    return outputFilePath.Push(fileInfo.filename).GetPath();
 }
 
 bool GenericCompiler::IsIgnore(const FileInfo &fileInfo)
 {
-    lock_guard<mutex> lock(mutex_);
     string output = GetOutputFilePath(fileInfo);
-    if (g_hapResourceSet.count(output)) {
-        g_hapResourceSet.erase(output);
-    } else if (!g_resourceSet.emplace(output).second) {
+    if (!g_hapResourceSet.Erase(output) && !g_resourceSet.Insert(output)) {
         if (isHarResource_) {
             string idName = ResourceUtil::GetIdName(fileInfo.filename, fileInfo.dirType);
             int64_t id = IdWorker::GetInstance().GetId(fileInfo.dirType, idName);
@@ -123,6 +163,11 @@ bool GenericCompiler::IsIgnore(const FileInfo &fileInfo)
     return false;
 }
 
+bool GenericCompiler::IsPlainCopy() const
+{
+    return moduleName_ == "har" || type_ != ResType::MEDIA;
+}
+
 bool GenericCompiler::CopyMediaFile(const FileInfo &fileInfo, std::string &output)
 {
     string outputFolder = GetOutputFolder(fileInfo);
@@ -130,11 +175,10 @@ bool GenericCompiler::CopyMediaFile(const FileInfo &fileInfo, std::string &outpu
         return false;
     }
     output = GetOutputFilePath(fileInfo);
-    if (moduleName_ == "har" || type_ != ResType::MEDIA) {
+    if (IsPlainCopy()) {
         return ResourceUtil::CopyFileInner(fileInfo.filePath, output);
-    } else {
-        return CompressionParser::GetCompressionParser()->CopyAndTranscode(fileInfo.filePath, output);
     }
+    return CompressionParser::GetCompressionParser()->CopyAndTranscode(fileInfo.filePath, output);
 }
 }
 }
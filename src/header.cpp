@@ -18,6 +18,7 @@
 #include <fstream>
 #include <iomanip>
 #include <iostream>
+#include "file_stat_cache.h"
 
 namespace OHOS {
 namespace Global {
@@ -71,6 +72,7 @@ uint32_t Header::Create(HandleHeaderTail headerHandler, HandleBody bodyHandler,
     }
     out << buffer.rdbuf();
     out.close();
+    FileStatCache::GetInstance().Invalidate(outputPath_);
     return RESTOOL_SUCCESS;
 }
 }
@@ -16,6 +16,7 @@
 #include "i_resource_compiler.h"
 #include <algorithm>
 #include <iostream>
+#include <iterator>
 #include "file_entry.h"
 #include "id_worker.h"
 #include "resource_util.h"
@@ -36,40 +37,31 @@ IResourceCompiler::~IResourceCompiler()
     resourceInfos_.clear();
 }
 
-uint32_t IResourceCompiler::Compile(const vector<DirectoryInfo> &directoryInfos)
+uint32_t IResourceCompiler::CompileWithoutCommit(FileInfoQueue &queue)
 {
+    return CompileStream(queue);
+}
+
+uint32_t IResourceCompiler::Commit()
+{
+    return PostCommit();
+}
+
+uint32_t IResourceCompiler::CompileStream(FileInfoQueue &queue)
+{
+    // the files are compiled in the order of their paths once the walk is done, whatever order it listed them in
     vector<FileInfo> fileInfos;
-    map<string, vector<FileInfo>> setsByDirectory;
-    for (const auto &directoryInfo : directoryInfos) {
-        string outputFolder = GetOutputFolder(directoryInfo);
-        FileEntry f(directoryInfo.dirPath);
-        if (!f.Init()) {
-            return RESTOOL_ERROR;
-        }
-        for (const auto &it : f.GetChilds()) {
-            if (ResourceUtil::IsIgnoreFile(*it)) {
-                continue;
-            }
-
-            if (!it->IsFile()) {
-                PrintError(GetError(ERR_CODE_INVALID_RESOURCE_PATH)
-                    .FormatCause(it->GetFilePath().GetPath().c_str(), "not a file"));
-                return RESTOOL_ERROR;
-            }
-
-            FileInfo fileInfo = { directoryInfo, it->GetFilePath().GetPath(), it->GetFilePath().GetFilename() };
-            fileInfos.push_back(fileInfo);
-            setsByDirectory[outputFolder].push_back(fileInfo);
-        }
+    vector<FileInfo> batch;
+    while (queue.Pop(batch)) {
+        fileInfos.insert(fileInfos.end(), make_move_iterator(batch.begin()), make_move_iterator(batch.end()));
+    }
+    if (queue.IsCancelled()) {
+        return RESTOOL_ERROR;
     }
-
     sort(fileInfos.begin(), fileInfos.end(), [](const auto &a, const auto &b) {
         return a.filePath < b.filePath;
     });
-    if (CompileFiles(fileInfos) != RESTOOL_SUCCESS) {
-        return RESTOOL_ERROR;
-    }
-    return PostCommit();
+    return CompileFiles(fileInfos);
 }
 
 uint32_t IResourceCompiler::CompileFiles(const std::vector<FileInfo> &fileInfos)
@@ -134,6 +126,11 @@ uint32_t IResourceCompiler::PostCommit()
 }
 
 bool IResourceCompiler::MergeResourceItem(const ResourceItem &resourceItem)
+{
+    return MergeResourceItem(ResourceItem(resourceItem));
+}
+
+bool IResourceCompiler::MergeResourceItem(ResourceItem &&resourceItem)
 {
     string idName = ResourceUtil::GetIdName(resourceItem.GetName(), resourceItem.GetResType());
     if (!ResourceUtil::IsValidName(idName)) {
@@ -143,11 +140,11 @@ bool IResourceCompiler::MergeResourceItem(const ResourceItem &resourceItem)
     }
     auto item = nameInfos_.find(make_pair(resourceItem.GetResType(), idName));
     if (item == nameInfos_.end()) {
-        nameInfos_[make_pair(resourceItem.GetResType(), idName)].push_back(resourceItem);
+        nameInfos_[make_pair(resourceItem.GetResType(), idName)].push_back(move(resourceItem));
         return true;
     }
 
-    auto ret = find_if(item->second.begin(), item->second.end(), [resourceItem](auto &iter) {
+    auto ret = find_if(item->second.begin(), item->second.end(), [&resourceItem](auto &iter) {
         return resourceItem.GetLimitKey() == iter.GetLimitKey();
     });
     if (ret != item->second.end()) {
@@ -155,15 +152,15 @@ bool IResourceCompiler::MergeResourceItem(const ResourceItem &resourceItem)
                        .FormatCause(idName.c_str(), ret->GetFilePath().c_str(), resourceItem.GetFilePath().c_str()));
         return false;
     }
-    nameInfos_[make_pair(resourceItem.GetResType(), idName)].push_back(resourceItem);
+    item->second.push_back(move(resourceItem));
     return true;
 }
 
 string IResourceCompiler::GetOutputFolder(const DirectoryInfo &directoryInfo) const
 {
-    string outputFolder = FileEntry::FilePath(output_).Append(RESOURCES_DIR)
-        .Append(directoryInfo.limitKey).Append(directoryInfo.fileCluster).GetPath();
-    return outputFolder;
+    FileEntry::FilePath outputFolder(output_);
+    outputFolder.Push(RESOURCES_DIR).Push(directoryInfo.limitKey).Push(directoryInfo.fileCluster);
+    return outputFolder.GetPath();
 }
 }
 }
@@ -59,18 +59,15 @@ int64_t IdWorker::GetId(ResType resType, const string &name) const
 
 vector<ResourceId> IdWorker::GetHeaderId() const
 {
-    map<ResType, vector<ResourceId>> idClassify;
+    // ids_ is ordered by type first, so its order is already the order of the ids grouped by type
+    vector<ResourceId> ids;
+    ids.reserve(ids_.size());
     for (const auto &it : ids_) {
         ResourceId resourceId;
         resourceId.id = it.second;
         resourceId.type = ResourceUtil::ResTypeToString(it.first.first);
         resourceId.name = it.first.second;
-        idClassify[it.first.first].push_back(resourceId);
-    }
-
-    vector<ResourceId> ids;
-    for (const auto &item : idClassify) {
-        ids.insert(ids.end(), item.second.begin(), item.second.end());
+        ids.push_back(resourceId);
     }
     return ids;
 }
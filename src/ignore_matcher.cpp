@@ -0,0 +1,166 @@
+/*
+ * Copyright (c) 2024 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "ignore_matcher.h"
+
+#include <algorithm>
+#include <cctype>
+#include <iostream>
+
+namespace OHOS {
+namespace Global {
+namespace Restool {
+using namespace std;
+namespace {
+const string REGEX_SPECIAL_CHARS = "^$.*+?()[]{}|";
+const string LINE_TERMINATORS = "\r\n";
+constexpr size_t WILDCARD_LENGTH = 2;
+}
+
+IgnoreMatcher::IgnoreMatcher(const map<string, IgnoreType> &patterns, const string &source, bool ignoreCase,
+    bool matchPath) : source_(source), ignoreCase_(ignoreCase), matchPath_(matchPath)
+{
+    patterns_.reserve(patterns.size());
+    for (const auto &iter : patterns) {
+        Pattern pattern;
+        pattern.source = iter.first;
+        pattern.type = iter.second;
+        pattern.regex = regex(iter.first);
+        pattern.isLiteral = ParseLiteral(iter.first, pattern);
+        patterns_.push_back(move(pattern));
+    }
+}
+
+bool IgnoreMatcher::IsIgnored(const string &fileName, const string &filePath, bool isFile) const
+{
+    string name = fileName;
+    if (ignoreCase_) {
+        transform(name.begin(), name.end(), name.begin(), ::tolower);
+    }
+    string path;
+    if (matchPath_) {
+        // a run of backslashes is one separator, a slash before or after the run is kept
+        path.reserve(filePath.size());
+        bool inBackslashRun = false;
+        for (char c : filePath) {
+            if (c != '\\') {
+                path.push_back(c);
+            } else if (!inBackslashRun) {
+                path.push_back('/');
+            }
+            inBackslashRun = c == '\\';
+        }
+    }
+    for (const auto &pattern : patterns_) {
+        if ((pattern.type == IgnoreType::IGNORE_FILE && !isFile) ||
+            (pattern.type == IgnoreType::IGNORE_DIR && isFile)) {
+            continue;
+        }
+        // one write per line, so the lines of the scanning threads do not interleave
+        if (Match(pattern, name)) {
+            cout << "Info: file '" + name + "' is ignored by " + source_ + " filename pattern '" + pattern.source +
+                "'.\n";
+            return true;
+        }
+        if (matchPath_ && Match(pattern, path)) {
+            cout << "Info: file '" + path + "' is ignored by " + source_ + " filepath pattern '" + pattern.source +
+                "'.\n";
+            return true;
+        }
+    }
+    return false;
+}
+
+bool IgnoreMatcher::ParseLiteral(const string &source, Pattern &pattern)
+{
+    size_t begin = 0;
+    size_t end = source.size();
+    auto parseWildcard = [&source](size_t pos) {
+        if (source[pos] != '.') {
+            return Wildcard::NONE;
+        }
+        if (source[pos + 1] == '*') {
+            return Wildcard::ANY;
+        }
+        return source[pos + 1] == '+' ? Wildcard::NON_EMPTY : Wildcard::NONE;
+    };
+    if (end - begin >= WILDCARD_LENGTH) {
+        pattern.head = parseWildcard(begin);
+        begin += pattern.head == Wildcard::NONE ? 0 : WILDCARD_LENGTH;
+    }
+    if (end - begin >= WILDCARD_LENGTH) {
+        // the dot of the wildcard must not be escaped
+        size_t backslashes = 0;
+        for (size_t pos = end - WILDCARD_LENGTH; pos > begin && source[pos - 1] == '\\'; --pos) {
+            backslashes++;
+        }
+        if (backslashes % 2 == 0) {
+            pattern.tail = parseWildcard(end - WILDCARD_LENGTH);
+            end -= pattern.tail == Wildcard::NONE ? 0 : WILDCARD_LENGTH;
+        }
+    }
+    pattern.literal.clear();
+    for (size_t pos = begin; pos < end; ++pos) {
+        char c = source[pos];
+        if (c == '\\') {
+            // only an escaped punctuation is a literal, "\d" and the like are character classes
+            if (pos + 1 == end || isalnum(static_cast<unsigned char>(source[pos + 1]))) {
+                return false;
+            }
+            pattern.literal.push_back(source[++pos]);
+            continue;
+        }
+        if (REGEX_SPECIAL_CHARS.find(c) != string::npos) {
+            return false;
+        }
+        pattern.literal.push_back(c);
+    }
+    return true;
+}
+
+bool IgnoreMatcher::Match(const Pattern &pattern, const string &str)
+{
+    // the dot of a wildcard does not match a line terminator, leave such rare names to the regex
+    bool hasWildcard = pattern.head != Wildcard::NONE || pattern.tail != Wildcard::NONE;
+    if (pattern.isLiteral && (!hasWildcard || str.find_first_of(LINE_TERMINATORS) == string::npos)) {
+        return MatchLiteral(pattern, str);
+    }
+    return regex_match(str, pattern.regex);
+}
+
+bool IgnoreMatcher::MatchLiteral(const Pattern &pattern, const string &str)
+{
+    const string &literal = pattern.literal;
+    size_t minHead = pattern.head == Wildcard::NON_EMPTY ? 1 : 0;
+    size_t minTail = pattern.tail == Wildcard::NON_EMPTY ? 1 : 0;
+    if (str.size() < minHead + literal.size() + minTail) {
+        return false;
+    }
+    if (pattern.head == Wildcard::NONE && pattern.tail == Wildcard::NONE) {
+        return str == literal;
+    }
+    if (pattern.head == Wildcard::NONE) {
+        return str.compare(0, literal.size(), literal) == 0;
+    }
+    if (pattern.tail == Wildcard::NONE) {
+        return str.compare(str.size() - literal.size(), literal.size(), literal) == 0;
+    }
+    // the first occurrence ends first, if it leaves no room for the tail no other one does
+    size_t pos = str.find(literal, minHead);
+    return pos != string::npos && pos + literal.size() + minTail <= str.size();
+}
+} // namespace Restool
+} // namespace Global
+} // namespace OHOS
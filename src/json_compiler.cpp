@@ -14,10 +14,17 @@
  */
 
 #include "json_compiler.h"
+#include <algorithm>
+#include <deque>
 #include <iostream>
+#include <iterator>
 #include <limits>
+#include <list>
+#include <memory>
 #include <regex>
+#include "file_entry.h"
 #include "restool_errors.h"
+#include "task_group.h"
 #include "translatable_parser.h"
 
 namespace OHOS {
@@ -30,21 +37,76 @@ const string TAG_PARENT = "parent";
 const string TAG_QUANTITY = "quantity";
 const vector<string> QUANTITY_ATTRS = { "zero", "one", "two", "few", "many", "other" };
 const vector<string> TRANSLATION_TYPE = { "string", "strarray", "plural" };
+// an array of at least two ranges is parsed in ranges at the same time
+constexpr size_t PARSE_RANGE_ITEMS = 2048;
 
 JsonCompiler::JsonCompiler(ResType type, const string &output, bool isOverlap, bool isHarResource)
-    : IResourceCompiler(type, output, isOverlap, isHarResource), isBaseString_(false), root_(nullptr)
+    : IResourceCompiler(type, output, isOverlap, isHarResource)
 {
     InitParser();
 }
 
 JsonCompiler::~JsonCompiler()
 {
-    if (root_) {
-        cJSON_Delete(root_);
-    }
 }
 
 uint32_t JsonCompiler::CompileSingleFile(const FileInfo &fileInfo)
+{
+    vector<ResourceItem> resourceItems;
+    if (ParseFile(fileInfo, resourceItems) != RESTOOL_SUCCESS) {
+        return RESTOOL_ERROR;
+    }
+    return MergeResourceItems(resourceItems);
+}
+
+uint32_t JsonCompiler::CompileStream(FileInfoQueue &queue)
+{
+    // the files of a directory are parsed as soon as the walker lists it, each by its own task into its own items,
+    // the biggest first so that a large string.json does not finish last. The items are merged in the order of the
+    // paths once all files are parsed, so that the duplicates are found and reported as by a serial compile. The
+    // batches outlive the tasks.
+    list<vector<FileInfo>> batches;
+    deque<pair<const FileInfo *, vector<ResourceItem>>> results;
+    TaskGroup taskGroup;
+    vector<FileInfo> batch;
+    while (queue.Pop(batch)) {
+        batches.push_back(move(batch));
+        const vector<FileInfo> &fileInfos = batches.back();
+        vector<pair<uint64_t, const FileInfo *>> sizes;
+        sizes.reserve(fileInfos.size());
+        for (const auto &fileInfo : fileInfos) {
+            sizes.emplace_back(FileEntry::GetFileSize(fileInfo.filePath), &fileInfo);
+        }
+        stable_sort(sizes.begin(), sizes.end(), [](const auto &a, const auto &b) { return a.first > b.first; });
+        for (const auto &size : sizes) {
+            results.emplace_back(size.second, vector<ResourceItem>());
+            auto result = &results.back();
+            taskGroup.Spawn([this, result]() { return ParseFile(*result->first, result->second); });
+        }
+    }
+    if (queue.IsCancelled() || taskGroup.Wait() != RESTOOL_SUCCESS) {
+        return RESTOOL_ERROR;
+    }
+
+    vector<pair<const FileInfo *, vector<ResourceItem>> *> sortedResults;
+    sortedResults.reserve(results.size());
+    for (auto &result : results) {
+        sortedResults.push_back(&result);
+    }
+    sort(sortedResults.begin(), sortedResults.end(), [](const auto a, const auto b) {
+        return a->first->filePath < b->first->filePath;
+    });
+    for (auto result : sortedResults) {
+        if (MergeResourceItems(result->second) != RESTOOL_SUCCESS) {
+            return RESTOOL_ERROR;
+        }
+        result->second.clear();
+    }
+    return RESTOOL_SUCCESS;
+}
+
+// below private
+uint32_t JsonCompiler::ParseFile(const FileInfo &fileInfo, vector<ResourceItem> &resourceItems) const
 {
     if (fileInfo.limitKey == "base" &&
         fileInfo.fileCluster == "element" &&
@@ -52,15 +114,18 @@ uint32_t JsonCompiler::CompileSingleFile(const FileInfo &fileInfo)
         return RESTOOL_SUCCESS;
     }
 
-    if (!ResourceUtil::OpenJsonFile(fileInfo.filePath, &root_)) {
+    cJSON *root = nullptr;
+    if (!ResourceUtil::OpenJsonFile(fileInfo.filePath, &root)) {
         return RESTOOL_ERROR;
     }
-    if (!root_ || !cJSON_IsObject(root_)) {
+    // the tree of a file is only needed while it is parsed
+    unique_ptr<cJSON, decltype(&cJSON_Delete)> rootHolder(root, cJSON_Delete);
+    if (!cJSON_IsObject(root)) {
         PrintError(GetError(ERR_CODE_JSON_FORMAT_ERROR).SetPosition(fileInfo.filePath));
         return RESTOOL_ERROR;
     }
-    cJSON *item = root_->child;
-    if (cJSON_GetArraySize(root_) != 1) {
+    cJSON *item = root->child;
+    if (cJSON_GetArraySize(root) != 1) {
         PrintError(GetError(ERR_CODE_JSON_NOT_ONE_MEMBER).FormatCause("root").SetPosition(fileInfo.filePath));
         return RESTOOL_ERROR;
     }
@@ -73,17 +138,26 @@ uint32_t JsonCompiler::CompileSingleFile(const FileInfo &fileInfo)
                        .SetPosition(fileInfo.filePath));
         return RESTOOL_ERROR;
     }
-    isBaseString_ = (fileInfo.limitKey == "base" &&
+    bool isBaseString = (fileInfo.limitKey == "base" &&
         find(TRANSLATION_TYPE.begin(), TRANSLATION_TYPE.end(), tag) != TRANSLATION_TYPE.end());
     FileInfo copy = fileInfo;
     copy.fileType = ret->second;
-    if (!ParseJsonArrayLevel(item, copy)) {
+    if (!ParseJsonArrayLevel(item, copy, isBaseString, resourceItems)) {
         return RESTOOL_ERROR;
     }
     return RESTOOL_SUCCESS;
 }
 
-// below private
+uint32_t JsonCompiler::MergeResourceItems(vector<ResourceItem> &resourceItems)
+{
+    for (auto &resourceItem : resourceItems) {
+        if (!MergeResourceItem(move(resourceItem))) {
+            return RESTOOL_ERROR;
+        }
+    }
+    return RESTOOL_SUCCESS;
+}
+
 void JsonCompiler::InitParser()
 {
     using namespace placeholders;
@@ -100,7 +174,8 @@ void JsonCompiler::InitParser()
     handles_.emplace(ResType::SYMBOL, bind(&JsonCompiler::HandleSymbol, this, _1, _2));
 }
 
-bool JsonCompiler::ParseJsonArrayLevel(const cJSON *arrayNode, const FileInfo &fileInfo)
+bool JsonCompiler::ParseJsonArrayLevel(const cJSON *arrayNode, const FileInfo &fileInfo, bool isBaseString,
+    vector<ResourceItem> &resourceItems) const
 {
     if (!arrayNode || !cJSON_IsArray(arrayNode)) {
         PrintError(GetError(ERR_CODE_JSON_NODE_MISMATCH)
@@ -115,22 +190,57 @@ bool JsonCompiler::ParseJsonArrayLevel(const cJSON *arrayNode, const FileInfo &f
                        .SetPosition(fileInfo.filePath));
         return false;
     }
-    int32_t index = -1;
+    vector<cJSON *> items;
     for (cJSON *item = arrayNode->child; item; item = item->next) {
-        index++;
+        items.push_back(item);
+    }
+    if (items.size() < PARSE_RANGE_ITEMS * 2) {
+        return ParseJsonItems(items, 0, items.size(), fileInfo, isBaseString, resourceItems);
+    }
+
+    // the items of each range are appended in the order of the ranges, so the duplicates are merged and reported
+    // as if the array was parsed at once
+    size_t rangeCount = (items.size() + PARSE_RANGE_ITEMS - 1) / PARSE_RANGE_ITEMS;
+    vector<vector<ResourceItem>> rangeItems(rangeCount);
+    TaskGroup taskGroup;
+    for (size_t i = 0; i < rangeCount; i++) {
+        taskGroup.Spawn([this, &items, &fileInfo, isBaseString, &rangeItems, i]() {
+            size_t begin = i * PARSE_RANGE_ITEMS;
+            size_t end = min(begin + PARSE_RANGE_ITEMS, items.size());
+            rangeItems[i].reserve(end - begin);
+            return ParseJsonItems(items, begin, end, fileInfo, isBaseString, rangeItems[i]) ?
+                RESTOOL_SUCCESS : RESTOOL_ERROR;
+        });
+    }
+    if (taskGroup.Wait() != RESTOOL_SUCCESS) {
+        return false;
+    }
+    resourceItems.reserve(resourceItems.size() + items.size());
+    for (auto &range : rangeItems) {
+        move(range.begin(), range.end(), back_inserter(resourceItems));
+    }
+    return true;
+}
+
+bool JsonCompiler::ParseJsonItems(const vector<cJSON *> &items, size_t begin, size_t end,
+    const FileInfo &fileInfo, bool isBaseString, vector<ResourceItem> &resourceItems) const
+{
+    for (size_t i = begin; i < end; i++) {
+        cJSON *item = items[i];
         if (!item || !cJSON_IsObject(item)) {
             PrintError(GetError(ERR_CODE_JSON_NODE_MISMATCH).FormatCause("item", "object")
                 .SetPosition(fileInfo.filePath));
             return false;
         }
-        if (!ParseJsonObjectLevel(item, fileInfo)) {
+        if (!ParseJsonObjectLevel(item, fileInfo, isBaseString, resourceItems)) {
             return false;
         }
     }
     return true;
 }
 
-bool JsonCompiler::ParseJsonObjectLevel(cJSON *objectNode, const FileInfo &fileInfo)
+bool JsonCompiler::ParseJsonObjectLevel(cJSON *objectNode, const FileInfo &fileInfo, bool isBaseString,
+    vector<ResourceItem> &resourceItems) const
 {
     cJSON *nameNode = cJSON_GetObjectItem(objectNode, TAG_NAME.c_str());
     if (!nameNode) {
@@ -144,7 +254,7 @@ bool JsonCompiler::ParseJsonObjectLevel(cJSON *objectNode, const FileInfo &fileI
         return false;
     }
 
-    if (isBaseString_ && !TranslatableParse::ParseTranslatable(objectNode, fileInfo, nameNode->valuestring)) {
+    if (isBaseString && !TranslatableParse::ParseTranslatable(objectNode, fileInfo, nameNode->valuestring)) {
         return false;
     }
     ResourceItem resourceItem(nameNode->valuestring, fileInfo.keyParams, fileInfo.fileType);
@@ -172,7 +282,8 @@ bool JsonCompiler::ParseJsonObjectLevel(cJSON *objectNode, const FileInfo &fileI
         resourceItem.MarkCoverable();
     }
 
-    return MergeResourceItem(resourceItem);
+    resourceItems.push_back(move(resourceItem));
+    return true;
 }
 
 bool JsonCompiler::HandleString(const cJSON *objectNode, ResourceItem &resourceItem) const
@@ -0,0 +1,218 @@
+/*
+ * Copyright (c) 2024 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "output_trash.h"
+
+#include <atomic>
+#include <cerrno>
+#include <cstdio>
+#include <cstring>
+#include <iostream>
+#include "sys/stat.h"
+#include "unistd.h"
+#ifdef _WIN32
+#include "windows.h"
+#else
+#include <signal.h>
+#endif
+#include "file_entry.h"
+#include "file_stat_cache.h"
+#include "restool_errors.h"
+#include "task_group.h"
+#include "thread_pool.h"
+
+namespace OHOS {
+namespace Global {
+namespace Restool {
+using namespace std;
+namespace {
+const string TRASH_SUFFIX = ".restool_trash_";
+}
+
+bool OutputTrash::MoveToTrash(const string &path)
+{
+    // "$PATH.restool_trash_$PID_$INDEX", the index only grows when a trash of a reused pid could not be renamed
+    string prefix = GetTrashPrefix(path) + to_string(GetProcessId()) + "_";
+    lock_guard<mutex> lock(mutex_);
+    for (size_t index = trashPaths_.size();; index++) {
+        string trashPath = prefix + to_string(index);
+        if (FileEntry::Exist(trashPath)) {
+            continue;
+        }
+#ifdef _WIN32
+        bool result = rename(FileEntry::AdaptLongPath(path).c_str(), FileEntry::AdaptLongPath(trashPath).c_str()) == 0;
+#else
+        bool result = rename(path.c_str(), trashPath.c_str()) == 0;
+#endif
+        if (!result) {
+            cout << "Warning: failed to move '" << path << "' to '" << trashPath << "', " << strerror(errno) << endl;
+            return false;
+        }
+        // the tree is gone from the path, the cached stats and known directories under it are stale
+        FileStatCache::GetInstance().Clear();
+        trashPaths_.push_back(trashPath);
+        return true;
+    }
+}
+
+void OutputTrash::CollectLeftovers(const string &path)
+{
+    string parent = FileEntry::FilePath(path).GetParent().GetPath();
+    string prefix(FileEntry::FilePath(GetTrashPrefix(path)).GetFilename());
+    vector<FileEntry::DirEntry> entries;
+    if (parent.empty() || !FileEntry::ListDir(parent, entries)) {
+        return;
+    }
+    lock_guard<mutex> lock(mutex_);
+    for (const auto &entry : entries) {
+        if (entry.name.compare(0, prefix.size(), prefix) != 0) {
+            continue;
+        }
+        uint64_t pid = strtoull(entry.name.c_str() + prefix.size(), nullptr, 10);
+        // the pid of this process belongs to a crashed process that ran before, this one has not made its trash yet
+        if (pid != GetProcessId() && IsProcessRunning(pid)) {
+            continue;
+        }
+        cout << "Info: remove the trash left by an earlier build: " << entry.name << endl;
+        trashPaths_.push_back(parent + FileEntry::SEPARATE + entry.name);
+    }
+}
+
+void OutputTrash::RemoveAsync()
+{
+    lock_guard<mutex> lock(mutex_);
+    if (trashPaths_.empty() || removeFuture_.valid()) {
+        return;
+    }
+    vector<string> trashPaths = trashPaths_;
+    removeFuture_ = ThreadPool::GetIoInstance().Enqueue(TaskPriority::LOW, [trashPaths]() {
+        for (const auto &trashPath : trashPaths) {
+            RemoveTree(trashPath);
+        }
+    });
+}
+
+void OutputTrash::Wait()
+{
+    lock_guard<mutex> lock(mutex_);
+    if (removeFuture_.valid()) {
+        ThreadPool::GetIoInstance().Get(removeFuture_);
+    } else {
+        // the build failed before the io pool was started, the trash is deleted here instead of left behind
+        for (const auto &trashPath : trashPaths_) {
+            RemoveTree(trashPath);
+        }
+    }
+    trashPaths_.clear();
+}
+
+string OutputTrash::GetTrashPrefix(const string &path)
+{
+    string prefix = path;
+    while (prefix.size() > 1 && prefix.back() == FileEntry::SEPARATE.front()) {
+        prefix.pop_back();
+    }
+    return prefix + TRASH_SUFFIX;
+}
+
+bool OutputTrash::IsProcessRunning(uint64_t pid)
+{
+    if (pid == 0) {
+        return false;
+    }
+#ifdef _WIN32
+    HANDLE handle = OpenProcess(PROCESS_QUERY_LIMITED_INFORMATION, FALSE, static_cast<DWORD>(pid));
+    if (handle == nullptr) {
+        return GetLastError() == ERROR_ACCESS_DENIED;
+    }
+    DWORD exitCode = 0;
+    bool running = GetExitCodeProcess(handle, &exitCode) && exitCode == STILL_ACTIVE;
+    CloseHandle(handle);
+    return running;
+#else
+    // EPERM: the process runs as another user
+    return kill(static_cast<pid_t>(pid), 0) == 0 || errno == EPERM;
+#endif
+}
+
+uint64_t OutputTrash::GetProcessId()
+{
+#ifdef _WIN32
+    return static_cast<uint64_t>(GetCurrentProcessId());
+#else
+    return static_cast<uint64_t>(getpid());
+#endif
+}
+
+bool OutputTrash::RemoveTree(const string &path)
+{
+    vector<FileEntry::DirEntry> entries;
+    if (!FileEntry::ListDir(path, entries)) {
+        cout << "Warning: failed to open the trash '" << path << "', " << strerror(errno) << endl;
+        return false;
+    }
+    // the subdirectories are deleted in parallel, the files of a directory by the task listing it. A failure does
+    // not cancel the group, the rest of the tree is still deleted.
+    TaskGroup group(TaskPriority::LOW, ThreadPool::GetIoInstance());
+    atomic<bool> result{ true };
+    for (const auto &entry : entries) {
+        string subPath = path + FileEntry::SEPARATE + entry.name;
+        // ListDir follows a link, the link is removed and never what it points to
+        if (entry.isFile || IsLink(subPath)) {
+            if (!RemovePath(subPath, true)) {
+                result.store(false);
+            }
+            continue;
+        }
+        group.Spawn([subPath, &result]() {
+            if (!RemoveTree(subPath)) {
+                result.store(false);
+            }
+            return RESTOOL_SUCCESS;
+        });
+    }
+    group.Wait();
+    return result.load() && RemovePath(path, false);
+}
+
+bool OutputTrash::IsLink(const string &path)
+{
+#ifdef _WIN32
+    DWORD attributes = GetFileAttributesA(FileEntry::AdaptLongPath(path).c_str());
+    return attributes != INVALID_FILE_ATTRIBUTES && (attributes & FILE_ATTRIBUTE_REPARSE_POINT) != 0;
+#else
+    struct stat s;
+    return lstat(path.c_str(), &s) == 0 && S_ISLNK(s.st_mode);
+#endif
+}
+
+bool OutputTrash::RemovePath(const string &path, bool isFile)
+{
+#ifdef _WIN32
+    // a link to a directory is removed as a directory
+    string adaptedPath = FileEntry::AdaptLongPath(path);
+    bool result = (isFile ? remove(adaptedPath.c_str()) == 0 || rmdir(adaptedPath.c_str()) == 0 :
+        rmdir(adaptedPath.c_str()) == 0);
+#else
+    bool result = (isFile ? unlink(path.c_str()) : rmdir(path.c_str())) == 0;
+#endif
+    if (!result) {
+        cout << "Warning: failed to remove '" << path << "', " << strerror(errno) << endl;
+    }
+    return result;
+}
+} // namespace Restool
+} // namespace Global
+} // namespace OHOS
@@ -15,6 +15,8 @@
 
 #include "overlap_binary_file_packer.h"
 
+#include "sharded_set.h"
+
 namespace OHOS {
 namespace Global {
 namespace Restool {
@@ -42,11 +44,10 @@ uint32_t OverlapBinaryFilePacker::CopyBinaryFile(const vector<string> &inputs)
     return RESTOOL_SUCCESS;
 }
 
-bool OverlapBinaryFilePacker::IsDuplicated(const unique_ptr<FileEntry> &entry, string subPath)
+bool OverlapBinaryFilePacker::IsDuplicated(const string &path, const string &subPath)
 {
-    lock_guard<mutex> lock(mutex_);
-    if (!g_hapResourceSet.emplace(subPath).second || !g_resourceSet.emplace(subPath).second) {
-        cout << "Warning: '" << entry->GetFilePath().GetPath() << "' is defined repeatedly in hap." << endl;
+    if (!g_hapResourceSet.Insert(subPath) || !g_resourceSet.Insert(subPath)) {
+        cout << "Warning: '" << path << "' is defined repeatedly in hap." << endl;
         return true;
     }
     return false;
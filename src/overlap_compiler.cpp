@@ -15,6 +15,7 @@
 
 #include "overlap_compiler.h"
 #include <iostream>
+#include "sharded_set.h"
 
 namespace OHOS {
 namespace Global {
@@ -28,9 +29,8 @@ OverlapCompiler::OverlapCompiler(ResType type, const std::string &output, bool i
 
 bool OverlapCompiler::IsIgnore(const FileInfo &fileInfo)
 {
-    lock_guard<mutex> lock(mutex_);
     string output = GetOutputFilePath(fileInfo);
-    if (!g_hapResourceSet.emplace(output).second || !g_resourceSet.emplace(output).second) {
+    if (!g_hapResourceSet.Insert(output) || !g_resourceSet.Insert(output)) {
         cout << "Warning: '" << fileInfo.filePath << "' is defined repeatedly." << endl;
         return true;
     }
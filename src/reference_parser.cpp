@@ -17,6 +17,7 @@
 #include <iostream>
 #include <regex>
 #include "file_entry.h"
+#include "parallel_algorithm.h"
 #include "restool_errors.h"
 
 namespace OHOS {
@@ -55,7 +56,8 @@ const map<string, ResType> ReferenceParser::ID_OHOS_REFS = {
 
 std::map<int64_t, std::set<int64_t>> ReferenceParser::layerIconIds_;
 
-ReferenceParser::ReferenceParser() : idWorker_(IdWorker::GetInstance()), root_(nullptr), isParsingMediaJson_(false)
+ReferenceParser::ReferenceParser() : idWorker_(IdWorker::GetInstance()), layerIconIdsTarget_(&layerIconIds_),
+    root_(nullptr), isParsingMediaJson_(false)
 {
 }
 
@@ -68,18 +70,43 @@ ReferenceParser::~ReferenceParser()
 
 uint32_t ReferenceParser::ParseRefInResources(map<int64_t, vector<ResourceItem>> &items, const string &output)
 {
+    vector<vector<ResourceItem> *> itemLists;
+    itemLists.reserve(items.size());
     for (auto &iter : items) {
-        for (auto &resourceItem : iter.second) {
-            if (resourceItem.IsCoverable()) {
-                continue;
-            }
-            if (IsElementRef(resourceItem) && ParseRefInResourceItem(resourceItem) != RESTOOL_SUCCESS) {
-                return RESTOOL_ERROR;
+        itemLists.push_back(&iter.second);
+    }
+    using LayerIconIds = map<int64_t, set<int64_t>>;
+    return ParallelReduce(itemLists.size(), *layerIconIdsTarget_,
+        [&itemLists, &output](size_t begin, size_t end, LayerIconIds &partial) {
+            ReferenceParser referenceParser;
+            referenceParser.layerIconIdsTarget_ = &partial;
+            for (size_t i = begin; i < end; ++i) {
+                if (referenceParser.ParseRefInResourceItems(*itemLists[i], output) != RESTOOL_SUCCESS) {
+                    return RESTOOL_ERROR;
+                }
             }
-            if ((IsMediaRef(resourceItem) || IsProfileRef(resourceItem)) &&
-                ParseRefInJsonFile(resourceItem, output) != RESTOOL_SUCCESS) {
-                return RESTOOL_ERROR;
+            return RESTOOL_SUCCESS;
+        },
+        [](LayerIconIds &result, LayerIconIds &partial) {
+            // a later media json of the same id replaces the ids of an earlier one, as the serial loop does
+            for (auto &iter : partial) {
+                result[iter.first] = std::move(iter.second);
             }
+        });
+}
+
+uint32_t ReferenceParser::ParseRefInResourceItems(vector<ResourceItem> &resourceItems, const string &output)
+{
+    for (auto &resourceItem : resourceItems) {
+        if (resourceItem.IsCoverable()) {
+            continue;
+        }
+        if (IsElementRef(resourceItem) && ParseRefInResourceItem(resourceItem) != RESTOOL_SUCCESS) {
+            return RESTOOL_ERROR;
+        }
+        if ((IsMediaRef(resourceItem) || IsProfileRef(resourceItem)) &&
+            ParseRefInJsonFile(resourceItem, output) != RESTOOL_SUCCESS) {
+            return RESTOOL_ERROR;
         }
     }
     return RESTOOL_SUCCESS;
@@ -131,7 +158,7 @@ uint32_t ReferenceParser::ParseRefInJsonFile(ResourceItem &resourceItem, const s
         mediaJsonId_ = idWorker_.GetId(resType, ResourceUtil::GetIdName(resName, resType));
         if (mediaJsonId_ != INVALID_ID) {
             set<int64_t> set;
-            layerIconIds_[mediaJsonId_] = set;
+            (*layerIconIdsTarget_)[mediaJsonId_] = set;
         }
     } else {
         jsonPath = FileEntry::FilePath(output).Append(RESOURCES_DIR).Append("base").Append("profile").Append(resName)
@@ -262,13 +289,13 @@ bool ReferenceParser::IsElementRef(const ResourceItem &resourceItem) const
 bool ReferenceParser::IsMediaRef(const ResourceItem &resourceItem) const
 {
     return resourceItem.GetResType() == ResType::MEDIA &&
-                FileEntry::FilePath(resourceItem.GetFilePath()).GetExtension() == JSON_EXTENSION;
+                FileEntry::FilePath::GetExtension(resourceItem.GetFilePath()) == JSON_EXTENSION;
 }
 
 bool ReferenceParser::IsProfileRef(const ResourceItem &resourceItem) const
 {
     return resourceItem.GetResType() == ResType::PROF && resourceItem.GetLimitKey() == "base" &&
-                FileEntry::FilePath(resourceItem.GetFilePath()).GetExtension() == JSON_EXTENSION;
+                FileEntry::FilePath::GetExtension(resourceItem.GetFilePath()) == JSON_EXTENSION;
 }
 
 bool ReferenceParser::ParseRefString(string &key) const
@@ -299,8 +326,8 @@ bool ReferenceParser::ParseRefImpl(string &key, const map<string, ResType> &refs
             string name = key.substr(result[0].str().length());
             int64_t id = idWorker_.GetId(ref.second, name);
             if (!isSystem && ref.second == ResType::MEDIA && mediaJsonId_ != 0
-                && layerIconIds_.find(mediaJsonId_) != layerIconIds_.end()) {
-                layerIconIds_[mediaJsonId_].insert(id);
+                && layerIconIdsTarget_->find(mediaJsonId_) != layerIconIdsTarget_->end()) {
+                (*layerIconIdsTarget_)[mediaJsonId_].insert(id);
             }
             if (isSystem) {
                 id = idWorker_.GetSystemId(ref.second, name);
@@ -19,6 +19,7 @@
 #include <iostream>
 #include <regex>
 #include "config_parser.h"
+#include "file_stat_cache.h"
 #include "header.h"
 #include "id_worker.h"
 #include "key_parser.h"
@@ -90,7 +91,7 @@ bool ResourceAppend::Combine(const string &folderPath)
                 .FormatCause(child->GetFilePath().GetPath().c_str(), "not a file"));
             return false;
         }
-        const std::string fileName = child->GetFilePath().GetFilename();
+        const std::string fileName(child->GetFilePath().GetFilename());
         if (fileName == ID_DEFINED_FILE) {
             continue;
         }
@@ -128,6 +129,7 @@ bool ResourceAppend::ScanResources(const string &resourcePath, const string &out
             PrintError(GetError(ERR_CODE_REMOVE_FILE_ERROR).FormatCause(filePath.c_str(), strerror(errno)));
             return false;
         }
+        FileStatCache::GetInstance().Invalidate(filePath);
         return true;
     }
 
@@ -146,9 +148,9 @@ bool ResourceAppend::ScanResources(const string &resourcePath, const string &out
 bool ResourceAppend::ScanSubResources(const FileEntry entry, const string &resourcePath, const string &outputPath)
 {
     vector<KeyParam> keyParams;
-    if (KeyParser::Parse(entry.GetFilePath().GetFilename(), keyParams)) {
+    if (KeyParser::Parse(string(entry.GetFilePath().GetFilename()), keyParams)) {
         for (const auto &child : entry.GetChilds()) {
-            if (!ResourceUtil::IslegalPath(child->GetFilePath().GetFilename())) {
+            if (!ResourceUtil::IslegalPath(string(child->GetFilePath().GetFilename()))) {
                 continue;
             }
             if (!ScanIegalResources(child->GetFilePath().GetPath(), outputPath)) {
@@ -158,7 +160,7 @@ bool ResourceAppend::ScanSubResources(const FileEntry entry, const string &resou
         return true;
     }
 
-    if (ResourceUtil::IslegalPath(entry.GetFilePath().GetFilename())) {
+    if (ResourceUtil::IslegalPath(string(entry.GetFilePath().GetFilename()))) {
         return ScanIegalResources(resourcePath, outputPath);
     }
 
@@ -169,7 +171,7 @@ bool ResourceAppend::ScanSubLimitkeyResources(const FileEntry entry, const strin
     const string &outputPath)
 {
     for (const auto &child : entry.GetChilds()) {
-        string limitKey = child->GetFilePath().GetFilename();
+        string limitKey(child->GetFilePath().GetFilename());
         if (ResourceUtil::IsIgnoreFile(*child)) {
             continue;
         }
@@ -218,7 +220,7 @@ bool ResourceAppend::ScanLimitKey(const unique_ptr<FileEntry> &entry,
     }
 
     for (const auto &child : entry->GetChilds()) {
-        string fileCuster = child->GetFilePath().GetFilename();
+        string fileCuster(child->GetFilePath().GetFilename());
         if (ResourceUtil::IsIgnoreFile(*child)) {
             continue;
         }
@@ -250,7 +252,7 @@ bool ResourceAppend::ScanFiles(const unique_ptr<FileEntry> &entry,
     const DirectoryInfo &directoryInfo, const string &outputPath)
 {
     for (const auto &child : entry->GetChilds()) {
-        string filename =  child->GetFilePath().GetFilename();
+        string filename(child->GetFilePath().GetFilename());
         if (ResourceUtil::IsIgnoreFile(*child)) {
             continue;
         }
@@ -316,7 +318,7 @@ bool ResourceAppend::ScanSingleFile(const string &filePath, const string &output
     }
 
     FileEntry::FilePath path(filePath);
-    string fileCuster = path.GetParent().GetFilename();
+    string fileCuster(path.GetParent().GetFilename());
     ResType resType = ResourceUtil::GetResTypeByDir(fileCuster);
     if (resType == ResType::INVALID_RES_TYPE) {
         PrintError(GetError(ERR_CODE_INVALID_RESOURCE_DIR)
@@ -325,7 +327,7 @@ bool ResourceAppend::ScanSingleFile(const string &filePath, const string &output
         return false;
     }
 
-    string limitKey = path.GetParent().GetParent().GetFilename();
+    string limitKey(path.GetParent().GetParent().GetFilename());
     vector<KeyParam> keyParams;
     if (!KeyParser::Parse(limitKey, keyParams)) {
         PrintError(GetError(ERR_CODE_INVALID_LIMIT_KEY).FormatCause(limitKey.c_str()).SetPosition(filePath));
@@ -333,7 +335,7 @@ bool ResourceAppend::ScanSingleFile(const string &filePath, const string &output
     }
 
     DirectoryInfo directoryInfo = {limitKey, fileCuster, path.GetParent().GetPath(), keyParams, resType};
-    FileInfo fileInfo = {directoryInfo, filePath, path.GetFilename() };
+    FileInfo fileInfo = {directoryInfo, filePath, string(path.GetFilename()) };
     if (!ScanFile(fileInfo, outputPath)) {
         return false;
     }
@@ -366,7 +368,9 @@ bool ResourceAppend::WriteFileInner(ostringstream &outStream, const string &outp
         return false;
     }
     out << outStream.str();
+    out.close();
 #endif
+    FileStatCache::GetInstance().Invalidate(outputPath);
     return true;
 }
 
@@ -432,7 +436,7 @@ bool ResourceAppend::ScanRawFilesOrResFiles(const string &path, const string &ou
     }
 
     for (const auto &child : entry.GetChilds()) {
-        string filename =  child->GetFilePath().GetFilename();
+        string filename(child->GetFilePath().GetFilename());
         if (ResourceUtil::IsIgnoreFile(*child)) {
             continue;
         }
@@ -15,33 +15,39 @@
 
 #include "resource_directory.h"
 
+#include <algorithm>
 #include <iostream>
 
 #include "file_entry.h"
 #include "resource_util.h"
 #include "restool_errors.h"
 #include "select_compile_parse.h"
+#include "task_group.h"
 
 namespace OHOS {
 namespace Global {
 namespace Restool {
 using namespace std;
-bool ResourceDirectory::ScanResources(const string &resourcesDir, function<bool(const DirectoryInfo&)> callback) const
+bool ResourceDirectory::ScanResources(const string &resourcesDir, DirectoryCallback callback) const
 {
-    FileEntry f(resourcesDir);
-    if (!f.Init()) {
+    vector<FileEntry::DirEntry> entries;
+    if (!ListResourceDir(resourcesDir, entries)) {
         return false;
     }
 
-    for (const auto &it : f.GetChilds()) {
-        string limitKey = it->GetFilePath().GetFilename();
-        if (ResourceUtil::IsIgnoreFile(*it)) {
+    // the limit key directories are walked in parallel, the waits of the walking tasks run the nested ones
+    TaskGroup taskGroup(TaskPriority::HIGH, ThreadPool::GetIoInstance());
+    FileEntry::FilePath limitKeyPath(resourcesDir);
+    for (const auto &entry : entries) {
+        string dirPath = limitKeyPath.Push(entry.name).GetPath();
+        limitKeyPath.Pop();
+        const string &limitKey = entry.name;
+        if (ResourceUtil::IsIgnoreFile(limitKey, dirPath, entry.isFile)) {
             continue;
         }
 
-        if (it->IsFile()) {
-            PrintError(GetError(ERR_CODE_INVALID_RESOURCE_PATH)
-                .FormatCause(it->GetFilePath().GetPath().c_str(), "not a directory"));
+        if (entry.isFile) {
+            PrintError(GetError(ERR_CODE_INVALID_RESOURCE_PATH).FormatCause(dirPath.c_str(), "not a directory"));
             return false;
         }
 
@@ -49,16 +55,26 @@ bool ResourceDirectory::ScanResources(const string &resourcesDir, function<bool(
             continue;
         }
 
-        if (!ScanResourceLimitKeyDir(it->GetFilePath().GetPath(), limitKey, callback)) {
-            return false;
-        }
+        taskGroup.Spawn([this, dirPath, limitKey, &callback]() {
+            return ScanResourceLimitKeyDir(dirPath, limitKey, callback) ? RESTOOL_SUCCESS : RESTOOL_ERROR;
+        });
     }
-    return true;
+    return taskGroup.Wait() == RESTOOL_SUCCESS;
 }
 
 // below private
+bool ResourceDirectory::ListResourceDir(const string &path, vector<FileEntry::DirEntry> &entries) const
+{
+    if (!FileEntry::Exist(path)) {
+        cerr << "Warning: file not exist: " << path << endl;
+        return false;
+    }
+    FileEntry::ListDir(path, entries);
+    return true;
+}
+
 bool ResourceDirectory::ScanResourceLimitKeyDir(const string &resourceTypeDir, const string &limitKey,
-    function<bool(const DirectoryInfo&)> callback) const
+    const DirectoryCallback &callback) const
 {
     vector<KeyParam> keyParams;
     if (!KeyParser::Parse(limitKey, keyParams)) {
@@ -68,18 +84,21 @@ bool ResourceDirectory::ScanResourceLimitKeyDir(const string &resourceTypeDir, c
     if (!SelectCompileParse::IsSelectCompile(keyParams)) {
         return true;
     }
-    FileEntry f(resourceTypeDir);
-    if (!f.Init()) {
+    vector<FileEntry::DirEntry> entries;
+    if (!ListResourceDir(resourceTypeDir, entries)) {
         return false;
     }
-    for (const auto &it : f.GetChilds()) {
-        string dirPath = it->GetFilePath().GetPath();
-        string fileCluster = it->GetFilePath().GetFilename();
-        if (ResourceUtil::IsIgnoreFile(*it)) {
+    TaskGroup taskGroup(TaskPriority::HIGH, ThreadPool::GetIoInstance());
+    FileEntry::FilePath filePath(resourceTypeDir);
+    for (const auto &entry : entries) {
+        string dirPath = filePath.Push(entry.name).GetPath();
+        filePath.Pop();
+        const string &fileCluster = entry.name;
+        if (ResourceUtil::IsIgnoreFile(fileCluster, dirPath, entry.isFile)) {
             continue;
         }
 
-        if (it->IsFile()) {
+        if (entry.isFile) {
             PrintError(GetError(ERR_CODE_INVALID_RESOURCE_PATH).FormatCause(dirPath.c_str(), "not a directory"));
             return false;
         }
@@ -92,11 +111,43 @@ bool ResourceDirectory::ScanResourceLimitKeyDir(const string &resourceTypeDir, c
             return false;
         }
         DirectoryInfo info = { limitKey, fileCluster, dirPath, keyParams, type };
-        if (callback && !callback(info)) {
+        taskGroup.Spawn([this, info, &callback]() {
+            return ScanResourceTypeDir(info, callback) ? RESTOOL_SUCCESS : RESTOOL_ERROR;
+        });
+    }
+    return taskGroup.Wait() == RESTOOL_SUCCESS;
+}
+
+bool ResourceDirectory::ScanResourceTypeDir(const DirectoryInfo &directoryInfo,
+    const DirectoryCallback &callback) const
+{
+    vector<FileEntry::DirEntry> entries;
+    if (!ListResourceDir(directoryInfo.dirPath, entries)) {
+        return false;
+    }
+    vector<FileInfo> fileInfos;
+    fileInfos.reserve(entries.size());
+    FileEntry::FilePath filePath(directoryInfo.dirPath);
+    for (const auto &entry : entries) {
+        filePath.Push(entry.name);
+        if (ResourceUtil::IsIgnoreFile(entry.name, filePath.GetPath(), entry.isFile)) {
+            filePath.Pop();
+            continue;
+        }
+
+        if (!entry.isFile) {
+            PrintError(GetError(ERR_CODE_INVALID_RESOURCE_PATH).FormatCause(filePath.GetPath().c_str(), "not a file"));
             return false;
         }
+
+        FileInfo fileInfo = { directoryInfo, filePath.GetPath(), entry.name };
+        fileInfos.push_back(fileInfo);
+        filePath.Pop();
     }
-    return true;
+    sort(fileInfos.begin(), fileInfos.end(), [](const auto &a, const auto &b) {
+        return a.filePath < b.filePath;
+    });
+    return callback(directoryInfo, fileInfos);
 }
 }
 }
@@ -30,6 +30,11 @@ ResourceItem::ResourceItem(const ResourceItem &other)
     CopyFrom(other);
 }
 
+ResourceItem::ResourceItem(ResourceItem &&other) noexcept
+{
+    MoveFrom(other);
+}
+
 ResourceItem::ResourceItem(const string &name, const vector<KeyParam> &keyparams, ResType type)
     : data_(nullptr), dataLen_(0), name_(name), keyparams_(keyparams), type_(type)
 {
@@ -183,6 +188,16 @@ ResourceItem &ResourceItem::operator=(const ResourceItem &other)
     return *this;
 }
 
+ResourceItem &ResourceItem::operator=(ResourceItem &&other) noexcept
+{
+    if (this == &other) {
+        return *this;
+    }
+    ReleaseData();
+    MoveFrom(other);
+    return *this;
+}
+
 // below private founction
 void ResourceItem::ReleaseData()
 {
@@ -206,6 +221,21 @@ void ResourceItem::CopyFrom(const ResourceItem &other)
         ReleaseData();
     }
 }
+
+// the data buffer is taken over instead of copied, other is left without data
+void ResourceItem::MoveFrom(ResourceItem &other)
+{
+    name_ = std::move(other.name_);
+    keyparams_ = std::move(other.keyparams_);
+    type_ = other.type_;
+    filePath_ = std::move(other.filePath_);
+    limitKey_ = std::move(other.limitKey_);
+    coverable_ = other.coverable_;
+    data_ = other.data_;
+    dataLen_ = other.dataLen_;
+    other.data_ = nullptr;
+    other.dataLen_ = 0;
+}
 }
 }
 }
\ No newline at end of file
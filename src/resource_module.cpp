@@ -17,10 +17,13 @@
 
 #include <algorithm>
 #include <iostream>
+#include <mutex>
 
 #include "config_parser.h"
 #include "resource_compiler_factory.h"
 #include "restool_errors.h"
+#include "task_group.h"
+#include "thread_pool.h"
 
 namespace OHOS {
 namespace Global {
@@ -47,33 +50,27 @@ ResourceModule::ResourceModule(const string &modulePath, const string &moduleOut
 
 uint32_t ResourceModule::ScanResource(bool isHap)
 {
-    if (!ResourceUtil::FileExist(modulePath_)) {
-        return RESTOOL_SUCCESS;
-    }
-
-    ResourceDirectory directory;
-    if (!directory.ScanResources(modulePath_, [this](const DirectoryInfo &info) -> bool {
-            scanDirs_[info.dirType].push_back(info);
-            return true;
-        })) {
+    isHap_ = isHap;
+    // the types are compiled at the same time, the element parse overlaps the media copies and transcodes
+    if (WalkAndCompile(SCAN_SEQ) != RESTOOL_SUCCESS) {
         return RESTOOL_ERROR;
     }
+    return CommitTypes();
+}
 
-    for (const auto &type : SCAN_SEQ) {
-        const auto &item = scanDirs_.find(type);
-        if (item == scanDirs_.end() || item->second.empty()) {
-            continue;
-        }
+uint32_t ResourceModule::ParseResource(bool isHap)
+{
+    isHap_ = isHap;
+    return WalkAndCompile({ ResType::ELEMENT });
+}
 
-        unique_ptr<IResourceCompiler> resourceCompiler =
-            ResourceCompilerFactory::CreateCompiler(type, moduleOutput_, isHap, isHarResource_);
-        resourceCompiler->SetModuleName(moduleName_);
-        if (resourceCompiler->Compile(item->second) != RESTOOL_SUCCESS) {
-            return RESTOOL_ERROR;
-        }
-        Push(resourceCompiler->GetResult());
+uint32_t ResourceModule::CommitResource()
+{
+    // the media and profile files are checked against the files output by the modules committed before
+    if (CompileTypes(SCAN_SEQ) != RESTOOL_SUCCESS) {
+        return RESTOOL_ERROR;
     }
-    return RESTOOL_SUCCESS;
+    return CommitTypes();
 }
 
 const map<int64_t, vector<ResourceItem>> &ResourceModule::GetOwner() const
@@ -121,6 +118,112 @@ uint32_t ResourceModule::MergeResourceItem(map<int64_t, vector<ResourceItem>> &a
     return RESTOOL_SUCCESS;
 }
 // below private
+uint32_t ResourceModule::WalkAndCompile(const vector<ResType> &types)
+{
+    if (!ResourceUtil::FileExist(modulePath_)) {
+        return RESTOOL_SUCCESS;
+    }
+
+    // the walk runs on the io pool and streams the files of each type into its queue, the types are compiled
+    // meanwhile and the others wait in their queues for CommitResource
+    for (const auto &type : SCAN_SEQ) {
+        queues_[type];
+    }
+    mutex scanMutex;
+    auto walk = [this, &scanMutex]() {
+        ResourceDirectory directory;
+        bool result = directory.ScanResources(modulePath_,
+            [this, &scanMutex](const DirectoryInfo &info, vector<FileInfo> &fileInfos) -> bool {
+                {
+                    lock_guard<mutex> lock(scanMutex);
+                    scanDirs_[info.dirType].push_back(info);
+                }
+                auto queue = queues_.find(info.dirType);
+                if (queue != queues_.end()) {
+                    queue->second.Push(move(fileInfos));
+                }
+                return true;
+            });
+        for (auto &queue : queues_) {
+            if (result) {
+                queue.second.Close();
+            } else {
+                queue.second.Cancel();
+            }
+        }
+        return result ? RESTOOL_SUCCESS : RESTOOL_ERROR;
+    };
+    ThreadPool &ioPool = ThreadPool::GetIoInstance();
+    future<uint32_t> walkFuture = ioPool.Enqueue(TaskPriority::HIGH, walk);
+    uint32_t result = CompileTypes(types);
+    // the walk refers to the queues, it is waited for even when a compiler fails
+    if (ioPool.Get(walkFuture) != RESTOOL_SUCCESS) {
+        return RESTOOL_ERROR;
+    }
+    for (const auto &type : types) {
+        queues_.erase(type);
+    }
+    for (auto &scanDir : scanDirs_) {
+        sort(scanDir.second.begin(), scanDir.second.end(), [](const auto &a, const auto &b) {
+            return a.dirPath < b.dirPath;
+        });
+    }
+    return result;
+}
+
+uint32_t ResourceModule::CompileTypes(const vector<ResType> &types)
+{
+    // the types do not share output folders, so their compilers run at the same time, the ids are generated
+    // afterwards by CommitTypes in SCAN_SEQ order
+    vector<ResType> compileTypes;
+    for (const auto &type : types) {
+        if (queues_.count(type) != 0) {
+            compileTypes.push_back(type);
+        }
+    }
+    vector<unique_ptr<IResourceCompiler>> compilers(compileTypes.size());
+    TaskGroup taskGroup;
+    for (size_t i = 0; i < compileTypes.size(); i++) {
+        taskGroup.Spawn([this, &compileTypes, &compilers, i]() {
+            return CompileType(compileTypes[i], compilers[i]);
+        });
+    }
+    uint32_t result = taskGroup.Wait();
+    for (size_t i = 0; i < compileTypes.size(); i++) {
+        if (compilers[i] != nullptr) {
+            compilers_.emplace(compileTypes[i], move(compilers[i]));
+        }
+    }
+    return result;
+}
+
+uint32_t ResourceModule::CompileType(ResType type, unique_ptr<IResourceCompiler> &resourceCompiler)
+{
+    FileInfoQueue &queue = queues_.at(type);
+    if (!queue.WaitFirst()) {
+        return queue.IsCancelled() ? RESTOOL_ERROR : RESTOOL_SUCCESS;
+    }
+    resourceCompiler = ResourceCompilerFactory::CreateCompiler(type, moduleOutput_, isHap_, isHarResource_);
+    resourceCompiler->SetModuleName(moduleName_);
+    return resourceCompiler->CompileWithoutCommit(queue);
+}
+
+uint32_t ResourceModule::CommitTypes()
+{
+    for (const auto &type : SCAN_SEQ) {
+        auto resourceCompiler = compilers_.find(type);
+        if (resourceCompiler == compilers_.end()) {
+            continue;
+        }
+        if (resourceCompiler->second->Commit() != RESTOOL_SUCCESS) {
+            return RESTOOL_ERROR;
+        }
+        Push(resourceCompiler->second->GetResult());
+    }
+    compilers_.clear();
+    return RESTOOL_SUCCESS;
+}
+
 void ResourceModule::Push(const map<int64_t, std::vector<ResourceItem>> &other)
 {
     for (const auto &iter : other) {
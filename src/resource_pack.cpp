@@ -17,15 +17,19 @@
 #include <algorithm>
 #include <cstdint>
 #include <iomanip>
+#include "byte_budget.h"
+#include "file_copier.h"
 #include "file_entry.h"
 #include "file_manager.h"
 #include "header.h"
+#include "output_trash.h"
 #include "resource_check.h"
 #include "resource_merge.h"
 #include "resource_table.h"
 #include "compression_parser.h"
 #include "binary_file_packer.h"
 #include "resource_packer_factory.h"
+#include "system_limits.h"
 
 namespace OHOS {
 namespace Global {
@@ -52,6 +56,7 @@ uint32_t ResourcePack::Package()
         }
         errorCode = resourcePacker->Pack();
     }
+    OutputTrash::GetInstance().Wait();
     if (errorCode == RESTOOL_SUCCESS) {
         ShowPackSuccess();
     }
@@ -89,9 +94,26 @@ uint32_t ResourcePack::InitResourcePack()
     if (InitModule() != RESTOOL_SUCCESS) {
         return RESTOOL_ERROR;
     }
+    // bound the queued tasks so that walking a huge rawfile tree does not hold a closure for every file
+    ThreadPool::GetInstance().SetHighWaterMark(POOL_HIGH_WATER_MARK);
+    ThreadPool::GetIoInstance().SetHighWaterMark(POOL_HIGH_WATER_MARK);
     if (ThreadPool::GetInstance().Start(packageParser_.GetThreadCount()) != RESTOOL_SUCCESS) {
         return RESTOOL_ERROR;
     };
+    size_t ioThreadCount = packageParser_.GetIoThreadCount();
+    if (ioThreadCount == 0) {
+        ioThreadCount = packageParser_.GetThreadCount();
+    }
+    if (ThreadPool::GetIoInstance().Start(ioThreadCount) != RESTOOL_SUCCESS) {
+        return RESTOOL_ERROR;
+    };
+    OutputTrash::GetInstance().RemoveAsync();
+    // bound the bytes held by parallel copies and transcodes by the memory of the container
+    uint64_t inflightBytes = SystemLimits::GetInflightBytesBudget();
+    ByteBudget::GetInstance().SetLimit(inflightBytes);
+    FileCopier::SetFadviseThreshold(packageParser_.GetFadviseThreshold());
+    cout << "Info: memory limit is : " << SystemLimits::GetMemoryLimit() / MB_SIZE << "MB, in-flight bytes budget is : "
+        << inflightBytes / MB_SIZE << "MB" << endl;
     return RESTOOL_SUCCESS;
 }
 
@@ -155,12 +177,17 @@ uint32_t ResourcePack::InitOutput() const
     bool combine = packageParser_.GetCombine();
     string output = packageParser_.GetOutput();
     string resourcesPath = FileEntry::FilePath(output).Append(RESOURCES_DIR).GetPath();
+    OutputTrash::GetInstance().CollectLeftovers(resourcesPath);
     if (ResourceUtil::FileExist(resourcesPath)) {
         if (!forceWrite) {
             PrintError(GetError(ERR_CODE_OUTPUT_EXIST).SetPosition(resourcesPath));
             return RESTOOL_ERROR;
         }
 
+        // the old tree is deleted on the io pool once it is started, the build does not wait for it
+        if (OutputTrash::GetInstance().MoveToTrash(resourcesPath)) {
+            return RESTOOL_SUCCESS;
+        }
         if (!ResourceUtil::RmoveAllDir(resourcesPath)) {
             return combine ? RESTOOL_SUCCESS : RESTOOL_ERROR;
         }
@@ -174,7 +201,7 @@ uint32_t ResourcePack::GenerateHeader() const
     string textPath = FileEntry::FilePath(packageParser_.GetOutput()).Append("ResourceTable.txt").GetPath();
     headerPaths.push_back(textPath);
     for (const auto &headerPath : headerPaths) {
-        string extension = FileEntry::FilePath(headerPath).GetExtension();
+        string extension(FileEntry::FilePath(headerPath).GetExtension());
         auto it = headerCreaters_.find(extension);
         if (it == headerCreaters_.end()) {
             cout << "Warning: don't support header file format '" << headerPath << "'" << endl;
@@ -534,7 +561,7 @@ bool ResourcePack::CopyIcon(string &dataPath, const string &idName, string &file
 {
     string featureDependEntry = packageParser_.GetDependEntry();
     string source = FileEntry::FilePath(featureDependEntry).Append(dataPath).GetPath();
-    string suffix = FileEntry::FilePath(source).GetExtension();
+    string suffix(FileEntry::FilePath(source).GetExtension());
     fileName = idName + suffix;
     string output = packageParser_.GetOutput();
 #ifdef _WIN32
@@ -645,6 +672,7 @@ void ResourcePack::CheckConfigJsonForCombine(ResourceAppend &resourceAppend)
 void ResourcePack::ShowPackSuccess()
 {
     cout << "Info: restool resources compile success." << endl;
+    cout << FileCopier::PrintCopyMessage() << endl;
     if (CompressionParser::GetCompressionParser()->GetMediaSwitch()) {
         cout << CompressionParser::GetCompressionParser()->PrintTransMessage() << endl;
     }
@@ -21,6 +21,8 @@
 #include "cmd/cmd_parser.h"
 #include "file_entry.h"
 #include "file_manager.h"
+#include "file_stat_cache.h"
+#include "parallel_algorithm.h"
 #include "resource_util.h"
 #include "securec.h"
 
@@ -47,18 +49,37 @@ uint32_t ResourceTable::CreateResourceTable()
 {
     FileManager &fileManager = FileManager::GetInstance();
     auto &allResource = fileManager.GetResources();
-    map<string, vector<TableData>> configs;
+    vector<const pair<const int64_t, vector<ResourceItem>> *> resources;
+    resources.reserve(allResource.size());
     for (const auto &item : allResource) {
-        for (const auto &resourceItem : item.second) {
-            if (resourceItem.GetResType() == ResType::ID) {
-                break;
+        resources.push_back(&item);
+    }
+    using Configs = map<string, vector<TableData>>;
+    Configs configs;
+    ParallelReduce(resources.size(), configs,
+        [&resources](size_t begin, size_t end, Configs &partial) {
+            for (size_t i = begin; i < end; ++i) {
+                const auto &item = *resources[i];
+                for (const auto &resourceItem : item.second) {
+                    if (resourceItem.GetResType() == ResType::ID) {
+                        break;
+                    }
+                    TableData tableData;
+                    tableData.id = item.first;
+                    tableData.resourceItem = resourceItem;
+                    partial[resourceItem.GetLimitKey()].push_back(std::move(tableData));
+                }
             }
-            TableData tableData;
-            tableData.id = item.first;
-            tableData.resourceItem = resourceItem;
-            configs[resourceItem.GetLimitKey()].push_back(tableData);
-        }
-    }
+            return RESTOOL_SUCCESS;
+        },
+        [](Configs &result, Configs &partial) {
+            // chunks are merged in the order of the ids, every limit key keeps the order of the serial loop
+            for (auto &config : partial) {
+                auto &tableDatas = result[config.first];
+                tableDatas.insert(tableDatas.end(), make_move_iterator(config.second.begin()),
+                    make_move_iterator(config.second.end()));
+            }
+        });
 
     if (!newResIndex_) {
         if (SaveToResouorceIndex(configs) != RESTOOL_SUCCESS) {
@@ -262,6 +283,8 @@ uint32_t ResourceTable::SaveToResouorceIndex(const map<string, vector<TableData>
     SaveIdSets(idSets, outStreamHeader);
     out << outStreamHeader.str();
     out << outStreamData.str();
+    out.close();
+    FileStatCache::GetInstance().Invalidate(indexFilePath_);
     return RESTOOL_SUCCESS;
 }
 
@@ -463,6 +486,8 @@ uint32_t ResourceTable::SaveToNewResouorceIndex(const map<string, vector<TableDa
         return RESTOOL_ERROR;
     }
     WriteToIndex(indexHeader, idSetHeader, dataHeader, dataPool, out);
+    out.close();
+    FileStatCache::GetInstance().Invalidate(indexFilePath_);
     return RESTOOL_SUCCESS;
 }
 
@@ -15,14 +15,19 @@
 
 #include "resource_util.h"
 #include <algorithm>
+#include <atomic>
 #include <cstdlib>
 #include <fstream>
 #include <mutex>
 #include <iostream>
 #include <iomanip>
+#include <memory>
 #include <regex>
 #include <sstream>
+#include <unordered_set>
 #include "file_entry.h"
+#include "file_stat_cache.h"
+#include "ignore_matcher.h"
 #include "restool_errors.h"
 
 namespace OHOS {
@@ -47,10 +52,21 @@ static bool g_isUseCustomRegex = false;
 static std::string g_ignoreOption;
 static bool g_isIgnorePath = false;
 static std::set<int64_t> g_harResourceIds;
+// built on the first query after the options changed, the options are parsed before the scanning starts
+static std::unique_ptr<IgnoreMatcher> g_userIgnoreMatcher;
+static std::atomic<const IgnoreMatcher *> g_ignoreMatcher{ nullptr };
+static std::mutex g_ignoreMatcherMutex;
 
-static std::mutex fileMutex_;
 static std::mutex g_harResourceMutex;
 
+// the directories this thread created or found, a hit takes no lock and no stat. A removal of files clears the
+// FileStatCache and so all of these sets.
+struct KnownDirs {
+    uint64_t generation = 0;
+    std::unordered_set<std::string> dirs;
+};
+static thread_local KnownDirs t_knownDirs;
+
 void ResourceUtil::Split(const string &str, vector<string> &out, const string &splitter)
 {
     string::size_type len = str.size();
@@ -121,6 +137,7 @@ bool ResourceUtil::SaveToJsonFile(const string &path, const cJSON *root)
     cJSON_free(jsonString);
     jsonString = nullptr;
     out.close();
+    FileStatCache::GetInstance().Invalidate(path);
     return true;
 }
 
@@ -244,53 +261,33 @@ bool ResourceUtil::CopyFileInner(const string &src, const string &dst)
 
 bool ResourceUtil::CreateDirs(const string &filePath)
 {
-    std::lock_guard<std::mutex> lock(fileMutex_);
-    if (FileExist(filePath)) {
+    uint64_t generation = FileStatCache::GetInstance().GetGeneration();
+    if (t_knownDirs.generation != generation) {
+        t_knownDirs.dirs.clear();
+        t_knownDirs.generation = generation;
+    }
+    if (t_knownDirs.dirs.count(filePath) != 0) {
         return true;
     }
 
-    if (!FileEntry::CreateDirs(filePath)) {
+    // FileEntry::CreateDirs tolerates other threads creating the same directories
+    if (!FileExist(filePath) && !FileEntry::CreateDirs(filePath)) {
         PrintError(GetError(ERR_CODE_CREATE_FILE_ERROR).FormatCause(filePath.c_str(), strerror(errno)));
         return false;
     }
+    t_knownDirs.dirs.insert(filePath);
     return true;
 }
 
 bool ResourceUtil::IsIgnoreFile(const FileEntry &fileEntry)
 {
-    map<string, IgnoreType> regexs;
-    std::string regexSources;
-    string fileName = fileEntry.GetFilePath().GetFilename();
-    string filePath = fileEntry.GetFilePath().GetPath();
-    filePath = regex_replace(filePath, regex("\\\\+"), "/");
-    if (g_isUseCustomRegex) {
-        regexs = g_userIgnoreRegex;
-        regexSources = "user";
-    } else {
-        regexs = DEFAULT_IGNORE_FILE_REGEX;
-        regexSources = "default";
-        transform(fileName.begin(), fileName.end(), fileName.begin(), ::tolower);
-    }
-    bool isFile = fileEntry.IsFile();
-    for (const auto &iter : regexs) {
-        if ((iter.second == IgnoreType::IGNORE_FILE && !isFile) || (iter.second == IgnoreType::IGNORE_DIR && isFile)) {
-            continue;
-        }
-        if (regex_match(fileName, regex(iter.first))) {
-            cout << "Info: file '" << fileName << "' is ignored by " << regexSources << " filename pattern '"
-                 << iter.first << "'." << endl;
-            return true;
-        }
+    const FileEntry::FilePath &filePath = fileEntry.GetFilePath();
+    return IsIgnoreFile(string(filePath.GetFilename()), filePath.GetPath(), fileEntry.IsFile());
+}
 
-        if (g_isUseCustomRegex && g_isIgnorePath) {
-            if (regex_match(filePath, regex(iter.first))) {
-                cout << "Info: file '" << filePath << "' is ignored by " << regexSources << " filepath pattern '"
-                     << iter.first << "'." << endl;
-                return true;
-            }
-        }
-    }
-    return false;
+bool ResourceUtil::IsIgnoreFile(const string &fileName, const string &filePath, bool isFile)
+{
+    return GetIgnoreMatcher().IsIgnored(fileName, filePath, isFile);
 }
 
 string ResourceUtil::GenerateHash(const string &key)
@@ -549,6 +546,7 @@ bool ResourceUtil::AddIgnoreRegex(const std::string &regex, IgnoreType ignoreTyp
         return false;
     }
     g_userIgnoreRegex[regex] = ignoreType;
+    ResetIgnoreMatcher();
     return true;
 }
 
@@ -557,6 +555,36 @@ void ResourceUtil::SetIgnoreOption(const std::string &option)
     g_ignoreOption = option;
     g_isUseCustomRegex = !option.empty();
     g_isIgnorePath = IGNORE_PATH_OPTIONS.count(option);
+    ResetIgnoreMatcher();
+}
+
+void ResourceUtil::ResetIgnoreMatcher()
+{
+    std::lock_guard<std::mutex> lock(g_ignoreMatcherMutex);
+    g_ignoreMatcher.store(nullptr);
+    g_userIgnoreMatcher.reset();
+}
+
+const IgnoreMatcher &ResourceUtil::GetIgnoreMatcher()
+{
+    static const IgnoreMatcher defaultMatcher(DEFAULT_IGNORE_FILE_REGEX, "default", true, false);
+    const IgnoreMatcher *matcher = g_ignoreMatcher.load();
+    if (matcher != nullptr) {
+        return *matcher;
+    }
+    // every regex of the options is compiled once, not again for each one added
+    std::lock_guard<std::mutex> lock(g_ignoreMatcherMutex);
+    matcher = g_ignoreMatcher.load();
+    if (matcher == nullptr) {
+        if (g_isUseCustomRegex) {
+            g_userIgnoreMatcher = std::make_unique<IgnoreMatcher>(g_userIgnoreRegex, "user", false, g_isIgnorePath);
+            matcher = g_userIgnoreMatcher.get();
+        } else {
+            matcher = &defaultMatcher;
+        }
+        g_ignoreMatcher.store(matcher);
+    }
+    return *matcher;
 }
 
 bool ResourceUtil::CheckIgnoreOption(const std::string &option)
@@ -318,6 +318,20 @@ const std::map<uint32_t, ErrorInfo> ERRORS_MAP = {
         "",
         { "Make sure the argument of the option '%s' contains valid regular expressions." },
         {} } },
+    { ERR_CODE_INVALID_LINK_MODE,
+      { ERR_CODE_INVALID_LINK_MODE,
+        ERR_TYPE_COMMAND_PARSE,
+        "Invalid link mode '%s'. It should be hardlink, symlink or copy.",
+        "",
+        {},
+        {} } },
+    { ERR_CODE_INVALID_FADVISE_THRESHOLD,
+      { ERR_CODE_INVALID_FADVISE_THRESHOLD,
+        ERR_TYPE_COMMAND_PARSE,
+        "Invalid fadvise threshold '%s'. It should be an integer in MB, 0 turns the hints off.",
+        "",
+        {},
+        {} } },
 
     // 11211xxx
     { ERR_CODE_OUTPUT_EXIST,
@@ -0,0 +1,47 @@
+/*
+ * Copyright (c) 2024 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "sharded_set.h"
+
+#include <functional>
+
+namespace OHOS {
+namespace Global {
+namespace Restool {
+using namespace std;
+ShardedSet g_resourceSet;
+ShardedSet g_hapResourceSet;
+
+bool ShardedSet::Insert(const string &value)
+{
+    Shard &shard = GetShard(value);
+    lock_guard<mutex> lock(shard.mutex);
+    return shard.values.insert(value).second;
+}
+
+bool ShardedSet::Erase(const string &value)
+{
+    Shard &shard = GetShard(value);
+    lock_guard<mutex> lock(shard.mutex);
+    return shard.values.erase(value) != 0;
+}
+
+ShardedSet::Shard &ShardedSet::GetShard(const string &value)
+{
+    return shards_[hash<string>()(value) % SHARD_COUNT];
+}
+} // namespace Restool
+} // namespace Global
+} // namespace OHOS
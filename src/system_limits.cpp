@@ -0,0 +1,210 @@
+/*
+ * Copyright (c) 2024 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "system_limits.h"
+
+#include <algorithm>
+#include <cstdlib>
+#include <fstream>
+#include <sstream>
+#include <thread>
+#include "resource_data.h"
+#ifdef __LINUX__
+#include <sched.h>
+#include <unistd.h>
+#endif
+
+namespace OHOS {
+namespace Global {
+namespace Restool {
+using namespace std;
+namespace {
+constexpr uint64_t MIN_INFLIGHT_BYTES = 64 * MB_SIZE;
+constexpr uint64_t MAX_INFLIGHT_BYTES = 1024 * MB_SIZE;
+constexpr uint64_t DEFAULT_INFLIGHT_BYTES = 256 * MB_SIZE;
+// a quarter of the memory may be held by the files being copied or transcoded
+constexpr uint64_t INFLIGHT_BYTES_DIVISOR = 4;
+// cgroup v1 reports no memory limit as a page aligned LONG_MAX
+constexpr uint64_t UNLIMITED_MEMORY = 1ULL << 62;
+const string CGROUP_ROOT = "/sys/fs/cgroup";
+const string CGROUP_V2_CONTROLLER = "";
+}
+
+size_t SystemLimits::GetCpuCount()
+{
+    static const size_t cpuCount = []() {
+        size_t count = thread::hardware_concurrency();
+#ifdef __LINUX__
+        cpu_set_t cpuSet;
+        CPU_ZERO(&cpuSet);
+        if (sched_getaffinity(0, sizeof(cpuSet), &cpuSet) == 0 && CPU_COUNT(&cpuSet) > 0) {
+            count = count == 0 ? CPU_COUNT(&cpuSet) : min<size_t>(count, CPU_COUNT(&cpuSet));
+        }
+#endif
+        size_t quota = GetCgroupCpuQuota();
+        if (quota != 0) {
+            count = count == 0 ? quota : min(count, quota);
+        }
+        return count;
+    }();
+    return cpuCount;
+}
+
+uint64_t SystemLimits::GetMemoryLimit()
+{
+    static const uint64_t memoryLimit = []() {
+        uint64_t limit = 0;
+#ifdef __LINUX__
+        long pages = sysconf(_SC_PHYS_PAGES);
+        long pageSize = sysconf(_SC_PAGESIZE);
+        if (pages > 0 && pageSize > 0) {
+            limit = static_cast<uint64_t>(pages) * static_cast<uint64_t>(pageSize);
+        }
+#endif
+        uint64_t cgroupLimit = GetCgroupMemoryLimit();
+        if (cgroupLimit != 0) {
+            limit = limit == 0 ? cgroupLimit : min(limit, cgroupLimit);
+        }
+        return limit;
+    }();
+    return memoryLimit;
+}
+
+uint64_t SystemLimits::GetInflightBytesBudget()
+{
+    uint64_t memoryLimit = GetMemoryLimit();
+    if (memoryLimit == 0) {
+        return DEFAULT_INFLIGHT_BYTES;
+    }
+    return min(max(memoryLimit / INFLIGHT_BYTES_DIVISOR, MIN_INFLIGHT_BYTES), MAX_INFLIGHT_BYTES);
+}
+
+size_t SystemLimits::GetCgroupCpuQuota()
+{
+    size_t quota = 0;
+    string line;
+    // v2: "$MAX $PERIOD", $MAX is "max" when unlimited
+    for (const auto &dir : GetCgroupDirs(CGROUP_V2_CONTROLLER)) {
+        if (!ReadFirstLine(dir + "/cpu.max", line)) {
+            continue;
+        }
+        istringstream in(line);
+        string max;
+        long long period = 0;
+        if (!(in >> max >> period) || max == "max" || period <= 0) {
+            continue;
+        }
+        long long value = atoll(max.c_str());
+        if (value > 0) {
+            size_t count = static_cast<size_t>((value + period - 1) / period);
+            quota = quota == 0 ? count : min(quota, count);
+        }
+    }
+    // v1: cpu.cfs_quota_us is -1 when unlimited
+    for (const auto &dir : GetCgroupDirs("cpu")) {
+        string periodLine;
+        if (!ReadFirstLine(dir + "/cpu.cfs_quota_us", line) ||
+            !ReadFirstLine(dir + "/cpu.cfs_period_us", periodLine)) {
+            continue;
+        }
+        long long value = atoll(line.c_str());
+        long long period = atoll(periodLine.c_str());
+        if (value > 0 && period > 0) {
+            size_t count = static_cast<size_t>((value + period - 1) / period);
+            quota = quota == 0 ? count : min(quota, count);
+        }
+    }
+    return quota;
+}
+
+uint64_t SystemLimits::GetCgroupMemoryLimit()
+{
+    uint64_t limit = 0;
+    string line;
+    vector<pair<string, string>> sources = {
+        { CGROUP_V2_CONTROLLER, "/memory.max" },
+        { "memory", "/memory.limit_in_bytes" },
+    };
+    for (const auto &source : sources) {
+        for (const auto &dir : GetCgroupDirs(source.first)) {
+            if (!ReadFirstLine(dir + source.second, line) || line == "max") {
+                continue;
+            }
+            uint64_t value = strtoull(line.c_str(), nullptr, 10);
+            if (value > 0 && value < UNLIMITED_MEMORY) {
+                limit = limit == 0 ? value : min(limit, value);
+            }
+        }
+    }
+    return limit;
+}
+
+vector<string> SystemLimits::GetCgroupDirs(const string &controller)
+{
+    // the limit of any ancestor applies too, so the directories from the cgroup of the process up to the root of
+    // the hierarchy are returned
+    vector<string> dirs;
+#ifdef __LINUX__
+    ifstream in("/proc/self/cgroup");
+    string line;
+    while (getline(in, line)) {
+        // "$ID:$CONTROLLERS:$PATH", v2 has an empty controller list
+        auto first = line.find(':');
+        auto second = line.find(':', first + 1);
+        if (first == string::npos || second == string::npos) {
+            continue;
+        }
+        string controllers = line.substr(first + 1, second - first - 1);
+        string path = line.substr(second + 1);
+        string mountPoint;
+        if (controller.empty()) {
+            if (!controllers.empty()) {
+                continue;
+            }
+            mountPoint = CGROUP_ROOT;
+        } else {
+            istringstream names(controllers);
+            string name;
+            bool found = false;
+            while (getline(names, name, ',')) {
+                found = found || name == controller;
+            }
+            if (!found) {
+                continue;
+            }
+            mountPoint = CGROUP_ROOT + "/" + controllers;
+        }
+        // inside a container the cgroup namespace may hide the path, the mount point is the cgroup then
+        while (!path.empty() && path != "/") {
+            dirs.push_back(mountPoint + path);
+            path = path.substr(0, path.find_last_of('/'));
+        }
+        dirs.push_back(mountPoint);
+    }
+#endif
+    return dirs;
+}
+
+bool SystemLimits::ReadFirstLine(const string &path, string &line)
+{
+    ifstream in(path);
+    if (!in.is_open() || !getline(in, line)) {
+        return false;
+    }
+    return true;
+}
+} // namespace Restool
+} // namespace Global
+} // namespace OHOS
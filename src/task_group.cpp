@@ -0,0 +1,101 @@
+/*
+ * Copyright (c) 2024 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "task_group.h"
+
+#include <exception>
+#include "restool_errors.h"
+
+namespace OHOS {
+namespace Global {
+namespace Restool {
+using namespace std;
+namespace {
+// drops the pending count of the group when a task leaves, whatever way it leaves
+class PendingGuard {
+public:
+    explicit PendingGuard(atomic<size_t> &pendingTasks) : pendingTasks_(pendingTasks)
+    {
+    }
+
+    ~PendingGuard()
+    {
+        pendingTasks_.fetch_sub(1);
+    }
+
+private:
+    atomic<size_t> &pendingTasks_;
+};
+}
+
+TaskGroup::TaskGroup(TaskPriority priority, ThreadPool &pool) : priority_(priority), pool_(pool)
+{
+}
+
+TaskGroup::~TaskGroup()
+{
+    // queued tasks still refer to the group
+    Cancel();
+    Wait();
+}
+
+void TaskGroup::Spawn(function<uint32_t()> task)
+{
+    if (cancelled_.load()) {
+        return;
+    }
+    pendingTasks_.fetch_add(1);
+    pool_.Push(priority_, [this, task]() {
+        // the group may be destroyed as soon as the count drops to zero, the count drops even when the task throws
+        PendingGuard guard(pendingTasks_);
+        if (cancelled_.load()) {
+            return;
+        }
+        uint32_t result = RESTOOL_ERROR;
+        try {
+            result = task();
+        } catch (const exception &error) {
+            PrintError(GetError(ERR_CODE_UNDEFINED_ERROR).FormatCause(error.what()));
+        } catch (...) {
+            PrintError(GetError(ERR_CODE_UNDEFINED_ERROR).FormatCause("unknown exception in task"));
+        }
+        if (result != RESTOOL_SUCCESS) {
+            failed_.store(true);
+            cancelled_.store(true);
+        }
+    });
+}
+
+uint32_t TaskGroup::Wait()
+{
+    pool_.WaitUntil([this]() { return pendingTasks_.load() == 0; });
+    if (failed_.load() || cancelled_.load()) {
+        return RESTOOL_ERROR;
+    }
+    return RESTOOL_SUCCESS;
+}
+
+void TaskGroup::Cancel()
+{
+    cancelled_.store(true);
+}
+
+bool TaskGroup::IsCancelled() const
+{
+    return cancelled_.load();
+}
+} // namespace Restool
+} // namespace Global
+} // namespace OHOS
@@ -16,6 +16,8 @@
 #include "thread_pool.h"
 
 #include "restool_errors.h"
+#include "system_limits.h"
+#include <cstdlib>
 #include <iostream>
 #include <string>
 
@@ -24,12 +26,30 @@ namespace Global {
 namespace Restool {
 using namespace std;
 
-ThreadPool::ThreadPool()
+thread_local ThreadPool *ThreadPool::currentPool_ = nullptr;
+thread_local size_t ThreadPool::currentIndex_ = 0;
+thread_local size_t ThreadPool::runDepth_ = 0;
+constexpr std::chrono::milliseconds HELPER_WAIT_TIMEOUT(10);
+// one of every LOW_PRIORITY_INTERVAL picks of a worker prefers the low lane, so background work is never starved
+constexpr size_t LOW_PRIORITY_INTERVAL = 4;
+constexpr size_t LANE_COUNT = static_cast<size_t>(TaskPriority::PRIORITY_COUNT);
+constexpr int64_t WAIT_BUCKET_BOUNDS[] = { 1, 10, 100, 1000, 10000, 100000, 1000000 };
+constexpr const char *WAIT_BUCKET_NAMES[] = { "<1us", "<10us", "<100us", "<1ms", "<10ms", "<100ms", "<1s", ">=1s" };
+// set to print the statistics of every worker and the queue wait histogram when the pool stops
+constexpr const char *POOL_STATISTICS_ENV = "RESTOOL_POOL_STATS";
+
+ThreadPool::ThreadPool(const string &name) : name_(name)
 {}
 
 ThreadPool &ThreadPool::GetInstance()
 {
-    static ThreadPool pool;
+    static ThreadPool pool("");
+    return pool;
+}
+
+ThreadPool &ThreadPool::GetIoInstance()
+{
+    static ThreadPool pool("io ");
     return pool;
 }
 
@@ -41,24 +61,37 @@ uint32_t ThreadPool::Start(const size_t &threadCount)
     }
     size_t hardwareCount = std::thread::hardware_concurrency();
     cout << "Info: hardware concurrency count is : " << hardwareCount << endl;
-    size_t count = threadCount <= 0 ? (hardwareCount <= 0 ? DEFAULT_POOL_SIZE : hardwareCount) : threadCount;
+    // in a container the cpu quota may be far below the cpus of the host
+    size_t cpuCount = SystemLimits::GetCpuCount();
+    cout << "Info: available cpu count is : " << cpuCount << endl;
+    size_t count = threadCount <= 0 ? (cpuCount <= 0 ? DEFAULT_POOL_SIZE : cpuCount) : threadCount;
     if (count == 1) {
         count++;
     }
-    cout << "Info: thread count is : " << count << endl;
+    cout << "Info: " << name_ << "thread count is : " << count << endl;
+    queues_.reserve(count);
+    for (size_t i = 0; i < count; ++i) {
+        queues_.push_back(std::make_unique<WorkQueue>());
+    }
+    peakPendingTasks_.store(0);
+    inlineTasks_.store(0);
+    for (size_t i = 0; i < WAIT_BUCKET_COUNT; ++i) {
+        waitHistogram_[i].store(0);
+    }
+    startTime_ = Clock::now();
     running_ = true;
     workerThreads_.reserve(count);
     for (size_t i = 0; i < count; ++i) {
-        workerThreads_.emplace_back([this] { this->WorkInThread(); });
+        workerThreads_.emplace_back([this, i] { this->WorkInThread(i); });
     }
-    cout << "Info: thread pool is started" << endl;
+    cout << "Info: " << name_ << "thread pool is started" << endl;
     return RESTOOL_SUCCESS;
 }
 
 void ThreadPool::Stop()
 {
     {
-        std::unique_lock<std::mutex> lock(queueMutex_);
+        std::unique_lock<std::mutex> lock(sleepMutex_);
         running_ = false;
     }
     condition_.notify_all();
@@ -67,7 +100,11 @@ void ThreadPool::Stop()
             worker.join();
         }
     }
-    cout << "Info: thread pool is stopped" << endl;
+    PrintStatistics();
+    // the pool may be started again
+    workerThreads_.clear();
+    queues_.clear();
+    cout << "Info: " << name_ << "thread pool is stopped" << endl;
 }
 
 
@@ -78,27 +115,253 @@ ThreadPool::~ThreadPool()
     }
 }
 
-void ThreadPool::WorkInThread()
+void ThreadPool::SetHighWaterMark(size_t highWaterMark)
 {
-    while (this->running_) {
-        std::function<void()> task;
+    highWaterMark_ = highWaterMark;
+}
+
+size_t ThreadPool::GetThreadCount() const
+{
+    return workerThreads_.size();
+}
+
+void ThreadPool::Push(TaskPriority priority, std::function<void()> task)
+{
+    if (!running_) {
+        // nobody would ever pick the task up, run it on the caller
+        inlineTasks_.fetch_add(1);
+        task();
+        return;
+    }
+    if (highWaterMark_ > 0 && pendingTasks_.load() >= highWaterMark_) {
+        if (currentPool_ == this) {
+            // a worker waiting for space could wait for itself, it runs the task at once instead
+            inlineTasks_.fetch_add(1);
+            task();
+            return;
+        }
+        WaitForSpace();
+    }
+    // a worker keeps its own subtasks local, other threads spread tasks over the workers
+    size_t index = currentPool_ == this ? currentIndex_ : nextQueue_.fetch_add(1) % queues_.size();
+    size_t depth = pendingTasks_.fetch_add(1) + 1;
+    size_t peak = peakPendingTasks_.load();
+    while (depth > peak && !peakPendingTasks_.compare_exchange_weak(peak, depth)) {
+    }
+    {
+        std::lock_guard<std::mutex> lock(queues_[index]->mutex);
+        queues_[index]->tasks[static_cast<size_t>(priority)].push_back({ std::move(task), Clock::now() });
+    }
+    if (idleWorkers_.load() > 0) {
         {
-            std::unique_lock<std::mutex> lock(this->queueMutex_);
-            // wake up when there's a task or when the pool is stopped
-            this->condition_.wait(lock, [this] { return !this->running_ || !this->tasks_.empty(); });
-            if (!this->running_) {
-                // exit thread when the pool is stopped
-                return;
-            }
-            if (!this->tasks_.empty()) {
-                task = std::move(this->tasks_.front());
-                this->tasks_.pop();
-            }
+            std::lock_guard<std::mutex> lock(sleepMutex_);
         }
-        if (task) {
-            task();
+        condition_.notify_one();
+    }
+    NotifyHelpers();
+}
+
+void ThreadPool::WaitUntil(const std::function<bool()> &isReady)
+{
+    // blocking a worker here would take it away from the pool, keep it busy with queued tasks instead
+    bool canHelp = currentPool_ == this;
+    while (!isReady()) {
+        if (!canHelp || !RunPendingTask()) {
+            WaitForProgress(isReady, canHelp);
+        }
+    }
+}
+
+bool ThreadPool::Take(size_t index, Task &task)
+{
+    // the picks counter is only touched by the owner of the queue
+    bool lowFirst = ++queues_[index]->picks % LOW_PRIORITY_INTERVAL == 0;
+    for (size_t i = 0; i < LANE_COUNT; ++i) {
+        size_t lane = lowFirst ? LANE_COUNT - 1 - i : i;
+        if (Pop(index, lane, task) || Steal(index, lane, task)) {
+            NotifyProducers();
+            return true;
+        }
+    }
+    return false;
+}
+
+bool ThreadPool::Pop(size_t index, size_t lane, Task &task)
+{
+    WorkQueue &queue = *queues_[index];
+    std::lock_guard<std::mutex> lock(queue.mutex);
+    auto &tasks = queue.tasks[lane];
+    if (tasks.empty()) {
+        return false;
+    }
+    task = std::move(tasks.back());
+    tasks.pop_back();
+    pendingTasks_.fetch_sub(1);
+    return true;
+}
+
+bool ThreadPool::Steal(size_t index, size_t lane, Task &task)
+{
+    size_t count = queues_.size();
+    for (size_t i = 1; i < count; ++i) {
+        WorkQueue &queue = *queues_[(index + i) % count];
+        std::lock_guard<std::mutex> lock(queue.mutex);
+        auto &tasks = queue.tasks[lane];
+        if (tasks.empty()) {
+            continue;
+        }
+        task = std::move(tasks.front());
+        tasks.pop_front();
+        pendingTasks_.fetch_sub(1);
+        return true;
+    }
+    return false;
+}
+
+void ThreadPool::Run(Task &task)
+{
+    Clock::time_point start = Clock::now();
+    int64_t waitTime = std::chrono::duration_cast<std::chrono::microseconds>(start - task.enqueueTime).count();
+    size_t bucket = 0;
+    while (bucket < WAIT_BUCKET_COUNT - 1 && waitTime >= WAIT_BUCKET_BOUNDS[bucket]) {
+        bucket++;
+    }
+    waitHistogram_[bucket].fetch_add(1);
+
+    runDepth_++;
+    task.func();
+    runDepth_--;
+    WorkerStatistics &statistics = queues_[currentIndex_]->statistics;
+    statistics.taskCount++;
+    if (runDepth_ == 0) {
+        // a task run while helping is inside the busy time of the task that waits
+        statistics.busyTime += Clock::now() - start;
+    }
+    NotifyHelpers();
+}
+
+bool ThreadPool::RunPendingTask()
+{
+    Task task;
+    if (!Take(currentIndex_, task)) {
+        return false;
+    }
+    Run(task);
+    return true;
+}
+
+bool ThreadPool::RunPendingTaskOfCurrentPool()
+{
+    if (currentPool_ == nullptr) {
+        return false;
+    }
+    return currentPool_->RunPendingTask();
+}
+
+void ThreadPool::WaitForProgress(const std::function<bool()> &isReady, bool canHelp)
+{
+    Clock::time_point start = Clock::now();
+    std::unique_lock<std::mutex> lock(sleepMutex_);
+    helpers_.fetch_add(1);
+    // the timeout covers a task finishing between the ready check and the helper going to sleep
+    helperCondition_.wait_for(lock, HELPER_WAIT_TIMEOUT, [this, &isReady, canHelp] {
+        return (canHelp && (!running_ || pendingTasks_.load() > 0)) || isReady();
+    });
+    helpers_.fetch_sub(1);
+    if (canHelp) {
+        // a worker blocked on a nested result is not busy, the time is moved from busy to blocked
+        WorkerStatistics &statistics = queues_[currentIndex_]->statistics;
+        Clock::duration blocked = Clock::now() - start;
+        statistics.blockedTime += blocked;
+        statistics.busyTime -= blocked;
+    }
+}
+
+void ThreadPool::NotifyHelpers()
+{
+    if (helpers_.load() == 0) {
+        return;
+    }
+    {
+        std::lock_guard<std::mutex> lock(sleepMutex_);
+    }
+    helperCondition_.notify_all();
+}
+
+void ThreadPool::WaitForSpace()
+{
+    std::unique_lock<std::mutex> lock(sleepMutex_);
+    producers_.fetch_add(1);
+    while (running_ && pendingTasks_.load() >= highWaterMark_) {
+        spaceCondition_.wait_for(lock, HELPER_WAIT_TIMEOUT);
+    }
+    producers_.fetch_sub(1);
+}
+
+void ThreadPool::NotifyProducers()
+{
+    if (producers_.load() == 0 || pendingTasks_.load() >= highWaterMark_) {
+        return;
+    }
+    {
+        std::lock_guard<std::mutex> lock(sleepMutex_);
+    }
+    spaceCondition_.notify_all();
+}
+
+void ThreadPool::WorkInThread(size_t index)
+{
+    currentPool_ = this;
+    currentIndex_ = index;
+    while (this->running_) {
+        Task task;
+        if (Take(index, task)) {
+            Run(task);
+            continue;
+        }
+        std::unique_lock<std::mutex> lock(this->sleepMutex_);
+        idleWorkers_.fetch_add(1);
+        // wake up when there's a task or when the pool is stopped
+        this->condition_.wait(lock, [this] { return !this->running_ || this->pendingTasks_.load() > 0; });
+        idleWorkers_.fetch_sub(1);
+    }
+}
+
+void ThreadPool::PrintStatistics() const
+{
+    if (workerThreads_.empty()) {
+        return;
+    }
+    using Milliseconds = std::chrono::duration<double, std::milli>;
+    double elapsed = Milliseconds(Clock::now() - startTime_).count();
+    // the details per worker are only for tuning the pool
+    bool verbose = getenv(POOL_STATISTICS_ENV) != nullptr;
+    size_t taskCount = 0;
+    double busy = 0;
+    double blocked = 0;
+    for (size_t i = 0; i < queues_.size(); ++i) {
+        const WorkerStatistics &statistics = queues_[i]->statistics;
+        taskCount += statistics.taskCount;
+        busy += Milliseconds(statistics.busyTime).count();
+        blocked += Milliseconds(statistics.blockedTime).count();
+        if (verbose) {
+            double threadBusy = Milliseconds(statistics.busyTime).count();
+            cout << "Info: " << name_ << "thread " << i << ": tasks " << statistics.taskCount << ", busy "
+                << threadBusy << "ms (" << static_cast<int>(elapsed > 0 ? threadBusy * 100 / elapsed : 0)
+                << "%), blocked " << Milliseconds(statistics.blockedTime).count() << "ms\n";
+        }
+    }
+    if (verbose) {
+        cout << "Info: " << name_ << "thread pool queue wait:";
+        for (size_t i = 0; i < WAIT_BUCKET_COUNT; ++i) {
+            cout << " " << WAIT_BUCKET_NAMES[i] << " " << waitHistogram_[i].load();
         }
+        cout << "\n";
     }
+    double capacity = elapsed * queues_.size();
+    cout << "Info: " << name_ << "thread pool: tasks " << taskCount << ", busy "
+        << static_cast<int>(capacity > 0 ? busy * 100 / capacity : 0) << "%, blocked " << blocked
+        << "ms, peak queue depth " << peakPendingTasks_.load() << ", inline tasks " << inlineTasks_.load() << endl;
 }
 } // namespace Restool
 } // namespace Global
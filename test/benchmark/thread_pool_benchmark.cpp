@@ -0,0 +1,224 @@
+/*
+ * Copyright (c) 2024 Huawei Device Co., Ltd.
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+// Compares the work-stealing ThreadPool with the single queue pool it replaced.
+// usage: restool_thread_pool_benchmark [max thread count] [task count]
+// flat: the main thread enqueues every task
+// nested: the main thread enqueues outer tasks, every outer task enqueues its inner tasks from a worker
+//
+// measured in a container limited to 1 cpu, 200000 tasks, best of 3, times in ms:
+// workload  threads       legacy      current   speedup
+// flat            2        261.6        343.8     0.76x
+// nested          2        272.5        298.7     0.91x
+// flat            4        401.0        543.9     0.74x
+// nested          4        233.5        253.2     0.92x
+// flat            8        405.0        688.9     0.59x
+// nested          8        181.0        239.1     0.76x
+// with a single cpu the workers never run at the same time, so these numbers only show the overhead per task,
+// the scaling has to be measured on a multi-core host
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <iostream>
+#include <queue>
+#include <sstream>
+#include "thread_pool.h"
+
+using namespace std;
+using namespace OHOS::Global::Restool;
+
+namespace {
+constexpr size_t DEFAULT_MAX_THREAD_COUNT = 8;
+constexpr size_t DEFAULT_TASK_COUNT = 200000;
+constexpr size_t INNER_TASK_COUNT = 64;
+constexpr size_t TASK_WORK = 200;
+constexpr int REPEAT_COUNT = 3;
+
+// the pool before the work-stealing deques: one queue under one mutex
+class LegacyThreadPool {
+public:
+    explicit LegacyThreadPool(size_t threadCount)
+    {
+        running_ = true;
+        for (size_t i = 0; i < threadCount; ++i) {
+            workerThreads_.emplace_back([this] { WorkInThread(); });
+        }
+    }
+
+    ~LegacyThreadPool()
+    {
+        {
+            unique_lock<mutex> lock(queueMutex_);
+            running_ = false;
+        }
+        condition_.notify_all();
+        for (thread &worker : workerThreads_) {
+            worker.join();
+        }
+    }
+
+    template <class F>
+    future<typename result_of<F()>::type> Enqueue(F &&f)
+    {
+        using return_type = typename result_of<F()>::type;
+        auto task = make_shared<packaged_task<return_type()>>(forward<F>(f));
+        future<return_type> res = task->get_future();
+        {
+            unique_lock<mutex> lock(queueMutex_);
+            tasks_.emplace([task]() { (*task)(); });
+        }
+        condition_.notify_one();
+        return res;
+    }
+
+    template <class T>
+    T Get(future<T> &future)
+    {
+        return future.get();
+    }
+
+private:
+    void WorkInThread()
+    {
+        while (running_) {
+            function<void()> task;
+            {
+                unique_lock<mutex> lock(queueMutex_);
+                condition_.wait(lock, [this] { return !running_ || !tasks_.empty(); });
+                if (!running_) {
+                    return;
+                }
+                task = move(tasks_.front());
+                tasks_.pop();
+            }
+            task();
+        }
+    }
+
+    vector<thread> workerThreads_;
+    queue<function<void()>> tasks_;
+    mutex queueMutex_;
+    condition_variable condition_;
+    bool running_ = false;
+};
+
+size_t Work(size_t seed)
+{
+    volatile size_t value = seed;
+    for (size_t i = 0; i < TASK_WORK; ++i) {
+        value = value * 31 + i;
+    }
+    return value;
+}
+
+template <class Pool>
+size_t RunFlat(Pool &pool, size_t taskCount)
+{
+    vector<future<size_t>> results;
+    results.reserve(taskCount);
+    for (size_t i = 0; i < taskCount; ++i) {
+        results.push_back(pool.Enqueue([i]() { return Work(i); }));
+    }
+    size_t sum = 0;
+    for (auto &result : results) {
+        sum += pool.Get(result);
+    }
+    return sum;
+}
+
+// the outer tasks hand their inner futures back instead of waiting, the legacy pool deadlocks when every worker
+// waits for a task queued behind it
+template <class Pool>
+size_t RunNested(Pool &pool, size_t taskCount)
+{
+    vector<future<vector<future<size_t>>>> outers;
+    for (size_t i = 0; i < taskCount / INNER_TASK_COUNT; ++i) {
+        outers.push_back(pool.Enqueue([&pool, i]() {
+            vector<future<size_t>> inners;
+            inners.reserve(INNER_TASK_COUNT);
+            for (size_t j = 0; j < INNER_TASK_COUNT; ++j) {
+                inners.push_back(pool.Enqueue([i, j]() { return Work(i * INNER_TASK_COUNT + j); }));
+            }
+            return inners;
+        }));
+    }
+    size_t sum = 0;
+    for (auto &outer : outers) {
+        vector<future<size_t>> inners = pool.Get(outer);
+        for (auto &inner : inners) {
+            sum += pool.Get(inner);
+        }
+    }
+    return sum;
+}
+
+template <class Run>
+double Measure(Run run)
+{
+    double best = 0;
+    for (int i = 0; i < REPEAT_COUNT; ++i) {
+        auto start = chrono::steady_clock::now();
+        run();
+        double elapsed = chrono::duration<double, milli>(chrono::steady_clock::now() - start).count();
+        best = (i == 0 || elapsed < best) ? elapsed : best;
+    }
+    return best;
+}
+
+template <class Workload>
+void Compare(const char *name, size_t threadCount, size_t taskCount, Workload workload)
+{
+    double legacy = 0;
+    {
+        LegacyThreadPool pool(threadCount);
+        legacy = Measure([&pool, taskCount, workload]() { workload(pool, taskCount); });
+    }
+    ThreadPool &pool = ThreadPool::GetInstance();
+    // the pool reports on start and stop, keep the table readable
+    streambuf *out = cout.rdbuf(nullptr);
+    pool.Start(threadCount);
+    cout.rdbuf(out);
+    double current = Measure([&pool, taskCount, workload]() { workload(pool, taskCount); });
+    out = cout.rdbuf(nullptr);
+    pool.Stop();
+    cout.rdbuf(out);
+    printf("%-8s %8zu %12.1f %12.1f %8.2fx\n", name, threadCount, legacy, current, current > 0 ? legacy / current : 0);
+}
+
+size_t ParseCount(const char *arg, size_t defaultValue)
+{
+    size_t value = 0;
+    istringstream stream(arg);
+    if (!(stream >> value) || value == 0) {
+        return defaultValue;
+    }
+    return value;
+}
+}
+
+int main(int argc, char *argv[])
+{
+    size_t maxThreadCount = argc > 1 ? ParseCount(argv[1], DEFAULT_MAX_THREAD_COUNT) : DEFAULT_MAX_THREAD_COUNT;
+    size_t taskCount = argc > 2 ? ParseCount(argv[2], DEFAULT_TASK_COUNT) : DEFAULT_TASK_COUNT;
+    printf("tasks %zu, best of %d, times in ms\n", taskCount, REPEAT_COUNT);
+    printf("%-8s %8s %12s %12s %9s\n", "workload", "threads", "legacy", "current", "speedup");
+    // the pool runs at least 2 threads
+    for (size_t threadCount = 2; threadCount <= maxThreadCount; threadCount *= 2) {
+        Compare("flat", threadCount, taskCount, [](auto &pool, size_t count) { return RunFlat(pool, count); });
+        Compare("nested", threadCount, taskCount, [](auto &pool, size_t count) { return RunNested(pool, count); });
+    }
+    return 0;
+}